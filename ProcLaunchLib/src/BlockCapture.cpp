@@ -0,0 +1,260 @@
+#include "BlockCapture.h"
+
+#include "GPUProcessorLauncher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr size_t HeaderSize {11u * sizeof(uint32_t)};
+constexpr size_t BlockHeaderSize {sizeof(uint64_t) + sizeof(uint32_t)};
+// number of blocks of the maximum launch size the ring holds while the writer thread catches up
+constexpr size_t RingBlocks {64u};
+
+template <typename T>
+T read_value(std::span<std::byte const> bytes, size_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+size_t mask_size(uint32_t nchannels_in) {
+    return (static_cast<size_t>(nchannels_in) + 3u) & ~size_t {3u};
+}
+} // namespace
+
+BlockRecorder::BlockRecorder(char const* path, LauncherSnapshot const& snapshot, CaptureSettings const& settings) :
+    m_file(path, std::ios::binary | std::ios::trunc),
+    m_nchannels_in {snapshot.m_executor_config.nchannels_in},
+    m_start {std::chrono::steady_clock::now()},
+    m_mask(mask_size(m_nchannels_in), 0u) {
+    if (!m_file) {
+        throw std::runtime_error("Failed to open capture file for writing");
+    }
+
+    std::vector<std::byte> const snapshot_bytes = snapshot.serialize();
+    uint32_t const header[] {
+        BlockCapture::Magic,
+        BlockCapture::Version,
+        settings.skip_silence ? 1u : 0u,
+        std::bit_cast<uint32_t>(settings.silence_threshold),
+        settings.has_deadline ? 1u : 0u,
+        static_cast<uint32_t>(settings.deadline.policy),
+        settings.deadline.deadline_us,
+        std::bit_cast<uint32_t>(settings.deadline.sample_rate),
+        static_cast<uint32_t>(settings.inactive_output),
+        static_cast<uint32_t>(settings.inactive_state),
+        static_cast<uint32_t>(snapshot_bytes.size())};
+    static_assert(sizeof(header) == HeaderSize);
+    m_file.write(reinterpret_cast<char const*>(header), sizeof(header));
+    m_file.write(reinterpret_cast<char const*>(snapshot_bytes.data()), static_cast<std::streamsize>(snapshot_bytes.size()));
+    if (!m_file) {
+        throw std::runtime_error("Failed to write capture file");
+    }
+
+    size_t const max_block_size = BlockHeaderSize + m_mask.size() + static_cast<size_t>(m_nchannels_in) * snapshot.m_executor_config.max_samples_per_channel * sizeof(float);
+    m_ring.resize(RingBlocks * max_block_size);
+    m_writer = std::thread([this] { write_loop(); });
+}
+
+BlockRecorder::~BlockRecorder() {
+    stop_writer();
+}
+
+void BlockRecorder::record(float const* const* input, uint32_t nsamples, uint8_t const* active_channels) {
+    if (m_overflow.load(std::memory_order_relaxed) || m_write_failed.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    size_t const channel_size = static_cast<size_t>(nsamples) * sizeof(float);
+    size_t const block_size = BlockHeaderSize + m_mask.size() + m_nchannels_in * channel_size;
+    uint64_t position = m_write_position.load(std::memory_order_relaxed);
+    if (block_size > m_ring.size() - (position - m_read_position.load(std::memory_order_acquire))) {
+        // dropping the block would make the replay diverge; stop the capture instead
+        m_overflow.store(true);
+        wake_up();
+        return;
+    }
+
+    uint64_t const timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+    for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+        m_mask[ch] = !active_channels || active_channels[ch] != 0u ? 1u : 0u;
+    }
+    put(position, &timestamp_ns, sizeof(timestamp_ns));
+    put(position, &nsamples, sizeof(nsamples));
+    put(position, m_mask.data(), m_mask.size());
+    for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+        put(position, input[ch], channel_size);
+    }
+    m_write_position.store(position, std::memory_order_release);
+    wake_up();
+}
+
+void BlockRecorder::finish() {
+    stop_writer();
+    if (m_write_failed.load()) {
+        throw std::runtime_error("Failed to write capture file");
+    }
+    if (m_overflow.load()) {
+        throw std::runtime_error("Capture stopped early; writing the capture file fell behind");
+    }
+}
+
+uint64_t BlockRecorder::get_memory_footprint() const {
+    return m_ring.capacity() + m_mask.capacity();
+}
+
+void BlockRecorder::write_loop() {
+    while (true) {
+        // remember the wake-up counter before checking for blocks to not miss a record or stop in between
+        uint32_t const wakeups = m_wakeups.load();
+        uint64_t const read_position = m_read_position.load(std::memory_order_relaxed);
+        uint64_t const write_position = m_write_position.load(std::memory_order_acquire);
+        if (read_position == write_position) {
+            if (m_stop.load()) {
+                break;
+            }
+            m_wakeups.wait(wakeups);
+            continue;
+        }
+
+        // the pending bytes may wrap around the end of the ring
+        size_t const offset = read_position % m_ring.size();
+        size_t const size = write_position - read_position;
+        size_t const first = std::min(size, m_ring.size() - offset);
+        m_file.write(reinterpret_cast<char const*>(m_ring.data() + offset), static_cast<std::streamsize>(first));
+        m_file.write(reinterpret_cast<char const*>(m_ring.data()), static_cast<std::streamsize>(size - first));
+        if (!m_file) {
+            m_write_failed.store(true);
+            return;
+        }
+        m_read_position.store(write_position, std::memory_order_release);
+    }
+
+    m_file.flush();
+    if (!m_file) {
+        m_write_failed.store(true);
+    }
+}
+
+void BlockRecorder::stop_writer() {
+    if (!m_writer.joinable()) {
+        return;
+    }
+    m_stop.store(true);
+    wake_up();
+    m_writer.join();
+}
+
+void BlockRecorder::put(uint64_t& position, void const* data, size_t size) {
+    size_t const offset = position % m_ring.size();
+    size_t const first = std::min(size, m_ring.size() - offset);
+    std::memcpy(m_ring.data() + offset, data, first);
+    std::memcpy(m_ring.data(), static_cast<std::byte const*>(data) + first, size - first);
+    position += size;
+}
+
+void BlockRecorder::wake_up() {
+    m_wakeups.fetch_add(1u);
+    m_wakeups.notify_one();
+}
+
+CaptureReader::CaptureReader(char const* path) :
+    m_file(path) {
+    std::span<std::byte const> const bytes = m_file.bytes();
+    if (bytes.size() < HeaderSize) {
+        throw std::runtime_error("Capture is truncated");
+    }
+    if (read_value<uint32_t>(bytes, 0u) != BlockCapture::Magic) {
+        throw std::runtime_error("Not a launcher capture");
+    }
+    if (read_value<uint32_t>(bytes, sizeof(uint32_t)) != BlockCapture::Version) {
+        throw std::runtime_error("Unsupported capture version");
+    }
+
+    size_t offset {2u * sizeof(uint32_t)};
+    auto const next = [&bytes, &offset] {
+        uint32_t const value = read_value<uint32_t>(bytes, offset);
+        offset += sizeof(uint32_t);
+        return value;
+    };
+    m_settings.skip_silence = next() != 0u;
+    m_settings.silence_threshold = std::bit_cast<float>(next());
+    m_settings.has_deadline = next() != 0u;
+    m_settings.deadline.policy = static_cast<DeadlinePolicy>(next());
+    m_settings.deadline.deadline_us = next();
+    m_settings.deadline.sample_rate = std::bit_cast<float>(next());
+    m_settings.inactive_output = static_cast<InactiveChannelOutput>(next());
+    m_settings.inactive_state = static_cast<InactiveChannelState>(next());
+
+    size_t const snapshot_size = next();
+    if (snapshot_size > bytes.size() - HeaderSize) {
+        throw std::runtime_error("Capture is truncated");
+    }
+    m_snapshot = LauncherSnapshot::parse(bytes.subspan(HeaderSize, snapshot_size));
+    m_blocks_offset = HeaderSize + snapshot_size;
+    m_offset = m_blocks_offset;
+}
+
+uint32_t CaptureReader::get_nchannels_in() const {
+    return m_snapshot.m_executor_config.nchannels_in;
+}
+
+uint32_t CaptureReader::get_nchannels_out() const {
+    if (m_snapshot.m_routing_matrix.empty()) {
+        return m_snapshot.m_executor_config.nchannels_out;
+    }
+    return static_cast<uint32_t>(m_snapshot.m_routing_matrix.size() / std::max(get_nchannels_in(), 1u));
+}
+
+std::unique_ptr<ProcessorLauncherInterface> CaptureReader::create_launcher() const {
+    // the specifications reference the mapping, which outlives the launcher's copies
+    auto launcher = std::make_unique<GPUProcessorLauncher>(m_snapshot.m_executor_config, m_snapshot.m_routing_matrix);
+    launcher->load_processors(m_snapshot.m_processors);
+    launcher->set_silence_skipping(m_settings.skip_silence, m_settings.silence_threshold);
+    if (m_settings.has_deadline) {
+        launcher->set_deadline(m_settings.deadline);
+    }
+    launcher->set_inactive_channel_output(m_settings.inactive_output);
+    launcher->set_inactive_channel_state(m_settings.inactive_state);
+    launcher->arm();
+    return launcher;
+}
+
+bool CaptureReader::next_block(CapturedBlock& block) {
+    std::span<std::byte const> const bytes = m_file.bytes();
+    // a capture that was not stopped cleanly may end with a partially written block; ignore it
+    if (bytes.size() - m_offset < BlockHeaderSize) {
+        return false;
+    }
+    uint64_t const timestamp_ns = read_value<uint64_t>(bytes, m_offset);
+    uint32_t const nsamples = read_value<uint32_t>(bytes, m_offset + sizeof(uint64_t));
+    size_t const block_mask_size = mask_size(get_nchannels_in());
+    size_t const channel_size = static_cast<size_t>(nsamples) * sizeof(float);
+    if (bytes.size() - m_offset - BlockHeaderSize < block_mask_size ||
+        (bytes.size() - m_offset - BlockHeaderSize - block_mask_size) / std::max(get_nchannels_in(), 1u) < channel_size) {
+        return false;
+    }
+
+    // all fields are 4-byte aligned, so the mask and the audio data are read straight from the mapping
+    block.timestamp_ns = timestamp_ns;
+    block.nsamples = nsamples;
+    size_t offset = m_offset + BlockHeaderSize;
+    uint8_t const* mask = reinterpret_cast<uint8_t const*>(bytes.data() + offset);
+    bool const all_active = std::all_of(mask, mask + get_nchannels_in(), [](uint8_t active) { return active != 0u; });
+    block.active_channels = all_active ? nullptr : mask;
+    offset += block_mask_size;
+    block.channels.resize(get_nchannels_in());
+    for (float const*& channel : block.channels) {
+        channel = reinterpret_cast<float const*>(bytes.data() + offset);
+        offset += channel_size;
+    }
+    m_offset = offset;
+    return true;
+}
+
+void CaptureReader::rewind() {
+    m_offset = m_blocks_offset;
+}
@@ -0,0 +1,145 @@
+#ifndef GPUA_BLOCK_CAPTURE_H
+#define GPUA_BLOCK_CAPTURE_H
+
+#include <CaptureReaderInterface.h>
+
+#include "LauncherSnapshot.h"
+#include "MappedFile.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * Append-only capture of a launcher's configuration and of the input of its process() calls.
+ *
+ * Layout (host byte order, all fields 4-byte aligned):
+ *   header:    magic, version, settings, snapshot size, followed by the launcher's serialized
+ *              LauncherSnapshot
+ *   settings:  silence skipping enabled, silence threshold (f32), deadline enabled, deadline policy, deadline in us,
+ *              sample rate (f32), inactive channel output
+ *   block:     timestamp in ns since the start of the capture (u64), nsamples, channel activity mask (one byte per
+ *              input channel, padded to 4 bytes), followed by the planar input audio data
+ *              (nchannels_in x nsamples f32)
+ */
+struct BlockCapture {
+    static constexpr uint32_t Magic = 0x5043504Cu; // "LPCP"
+    static constexpr uint32_t Version = 1u;
+};
+
+/**
+ * Launcher settings that are not part of the LauncherSnapshot but change the processing of the captured blocks
+ */
+struct CaptureSettings {
+    bool skip_silence {false};
+    float silence_threshold {0.f};
+    bool has_deadline {false};
+    DeadlineConfig deadline {};
+    InactiveChannelOutput inactive_output {InactiveChannelOutput::eZero};
+    InactiveChannelState inactive_state {InactiveChannelState::eFrozen};
+};
+
+/**
+ * Writes a capture. The launcher's processing thread copies the blocks into a preallocated ring; a writer thread
+ * appends them to the file s.t. process() neither blocks on the file nor allocates.
+ */
+class BlockRecorder {
+public:
+    /**
+     * @brief Constructor; creates the capture file, writes the header and starts the writer thread
+     * @param path [in] path of the capture file to write
+     * @param snapshot [in] configuration and processors of the captured launcher
+     * @param settings [in] settings of the captured launcher
+     */
+    BlockRecorder(char const* path, LauncherSnapshot const& snapshot, CaptureSettings const& settings);
+
+    /**
+     * @brief Destructor; writes the remaining blocks and joins the writer thread
+     */
+    ~BlockRecorder();
+
+    BlockRecorder(BlockRecorder const&) = delete;
+    BlockRecorder& operator=(BlockRecorder const&) = delete;
+
+    /**
+     * @brief Append an input block to the capture. Never blocks and never throws; if the ring is full or the file can't
+     * be written, the capture stops and finish() reports it.
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param nsamples [in] number of samples per channel
+     * @param active_channels [in] one entry per input channel; 0 marks an inactive channel; nullptr if all are active
+     */
+    void record(float const* const* input, uint32_t nsamples, uint8_t const* active_channels);
+
+    /**
+     * @brief Write the remaining blocks and close the capture; throws if the capture stopped early
+     */
+    void finish();
+
+    /**
+     * @brief Get the number of bytes of host memory held by the ring
+     */
+    uint64_t get_memory_footprint() const;
+
+private:
+    void write_loop();
+    void stop_writer();
+    void put(uint64_t& position, void const* data, size_t size);
+    void wake_up();
+
+    std::ofstream m_file;
+    uint32_t const m_nchannels_in;
+    std::chrono::steady_clock::time_point const m_start;
+
+    // activity mask of the current block, padded to 4 bytes
+    std::vector<uint8_t> m_mask;
+    // blocks in file layout; the positions count bytes since the start of the capture
+    std::vector<std::byte> m_ring;
+    std::atomic<uint64_t> m_write_position {0u};
+    std::atomic<uint64_t> m_read_position {0u};
+
+    std::atomic<uint32_t> m_wakeups {0u};
+    std::atomic<bool> m_stop {false};
+    // a block didn't fit into the ring; the capture stopped
+    std::atomic<bool> m_overflow {false};
+    // the writer thread failed to write the file; the capture stopped
+    std::atomic<bool> m_write_failed {false};
+
+    std::thread m_writer;
+};
+
+/**
+ * Reads a capture from a read-only mapping; implements the CaptureReaderInterface
+ */
+class CaptureReader : public CaptureReaderInterface {
+public:
+    /**
+     * @brief Constructor; maps the capture file and validates the header
+     * @param path [in] path of the capture file to read
+     */
+    explicit CaptureReader(char const* path);
+
+    ////////////////////////////////
+    // CaptureReaderInterface methods
+    virtual uint32_t get_nchannels_in() const override;
+    virtual uint32_t get_nchannels_out() const override;
+    virtual std::unique_ptr<ProcessorLauncherInterface> create_launcher() const override;
+    virtual bool next_block(CapturedBlock& block) override;
+    virtual void rewind() override;
+    // CaptureReaderInterface methods
+    ////////////////////////////////
+
+private:
+    MappedFile m_file;
+    LauncherSnapshot m_snapshot;
+    CaptureSettings m_settings;
+    // offset of the first block and of the block that is read next
+    size_t m_blocks_offset {0u};
+    size_t m_offset {0u};
+};
+
+#endif // GPUA_BLOCK_CAPTURE_H
@@ -0,0 +1,103 @@
+#ifndef GPUA_CHANNEL_MASK_H
+#define GPUA_CHANNEL_MASK_H
+
+#include <ProcessorLauncherInterface.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Prepares the channel pointers of a process() call with a channel activity mask: inactive input channels read a
+ * shared silent buffer and the outputs of inactive channels are written to a discarded buffer.
+ */
+class ChannelMask {
+public:
+    /**
+     * @brief Constructor
+     * @param nchannels_in [in] number of input channels
+     * @param nchannels_out [in] number of output channels
+     * @param map_outputs [in] whether output channel ch belongs to input channel ch; otherwise, all outputs are written
+     */
+    ChannelMask(uint32_t nchannels_in, uint32_t nchannels_out, bool map_outputs) :
+        m_nchannels_in {nchannels_in},
+        m_nchannels_out {nchannels_out},
+        m_nmapped {map_outputs ? std::min(nchannels_in, nchannels_out) : 0u},
+        m_input(nchannels_in),
+        m_output(nchannels_out) {
+    }
+
+    /**
+     * @brief Prepare the channel pointers of a block; the buffers grow if the block is larger than all previous ones
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param output [in] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     * @param active_channels [in] one entry per input channel; 0 marks an inactive channel
+     * @return false if all channels are inactive
+     */
+    bool prepare(float const* const* input, float* const* output, uint32_t nsamples, uint8_t const* active_channels) {
+        if (nsamples > m_capacity) {
+            m_capacity = nsamples;
+            m_silence.assign(m_capacity, 0.f);
+            m_discard.resize(m_capacity);
+        }
+
+        bool any_active {false};
+        for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+            any_active |= active_channels[ch] != 0u;
+            m_input[ch] = active_channels[ch] != 0u ? input[ch] : m_silence.data();
+        }
+        for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+            m_output[ch] = ch < m_nmapped && active_channels[ch] == 0u ? m_discard.data() : output[ch];
+        }
+        return any_active;
+    }
+
+    /**
+     * @brief Write the outputs of inactive channels according to the policy
+     * @param output [in] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     * @param active_channels [in] one entry per input channel; 0 marks an inactive channel
+     * @param all_inactive [in] whether the block was skipped; then all outputs belong to inactive channels
+     * @param policy [in] what to write to the outputs of inactive channels
+     */
+    void finish(float* const* output, uint32_t nsamples, uint8_t const* active_channels, bool all_inactive, InactiveChannelOutput policy) const {
+        if (policy != InactiveChannelOutput::eZero) {
+            return;
+        }
+        for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+            if (all_inactive || (ch < m_nmapped && active_channels[ch] == 0u)) {
+                std::fill_n(output[ch], nsamples, 0.f);
+            }
+        }
+    }
+
+    float const* const* input() const {
+        return m_input.data();
+    }
+
+    float* const* output() const {
+        return m_output.data();
+    }
+
+    /**
+     * @brief Get the number of bytes of host memory held by the buffers and the channel pointers
+     */
+    uint64_t memory_footprint() const {
+        return (m_silence.capacity() + m_discard.capacity()) * sizeof(float) + (m_input.capacity() + m_output.capacity()) * sizeof(float*);
+    }
+
+private:
+    uint32_t const m_nchannels_in;
+    uint32_t const m_nchannels_out;
+    uint32_t const m_nmapped;
+    uint32_t m_capacity {0u};
+    // read by all inactive input channels; the launches never write it
+    std::vector<float> m_silence;
+    // written by the outputs of all inactive channels; never read
+    std::vector<float> m_discard;
+    std::vector<float const*> m_input;
+    std::vector<float*> m_output;
+};
+
+#endif // GPUA_CHANNEL_MASK_H
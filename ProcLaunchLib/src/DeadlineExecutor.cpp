@@ -0,0 +1,197 @@
+#include "DeadlineExecutor.h"
+
+#include "ProcessingThread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+void DeadlineExecutor::check_config(DeadlineConfig const& config) {
+    if (config.deadline_us == 0u && !(config.sample_rate > 0.f)) {
+        throw std::runtime_error("Deadline derived from the block size needs a positive sample rate");
+    }
+}
+
+DeadlineExecutor::DeadlineExecutor(uint32_t nchannels_in, uint32_t nchannels_out, DeadlineConfig const& config, ProcessFunction process) :
+    m_nchannels_in {nchannels_in},
+    m_nchannels_out {nchannels_out},
+    m_config {config},
+    m_process {std::move(process)},
+    m_input_ptrs(nchannels_in),
+    m_output_ptrs(nchannels_out) {
+    check_config(m_config);
+    m_thread = start_processing_thread("gpua-deadline", [this] { deadline_loop(); });
+}
+
+DeadlineExecutor::~DeadlineExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // a late block still uses the buffers; let it finish
+        m_cv.wait(lock, [this] { return !m_busy; });
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+bool DeadlineExecutor::process(float const* const* input, float* const* output, uint32_t nsamples) {
+    std::chrono::microseconds deadline {m_config.deadline_us};
+    if (deadline.count() == 0) {
+        deadline = std::chrono::microseconds(static_cast<int64_t>(1e6 * nsamples / m_config.sample_rate));
+    }
+    auto const deadline_time = std::chrono::steady_clock::now() + deadline;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+    // the previous block is late and still running; this one would miss its deadline waiting for it
+    if (m_busy) {
+        lock.unlock();
+        apply_policy(input, output, nsamples);
+        return false;
+    }
+
+    post(input, nsamples);
+
+    // the recent launches took longer than the deadline; don't wait for the result but keep the processors' state going
+    if (predicted_duration() > deadline) {
+        lock.unlock();
+        apply_policy(input, output, nsamples);
+        return false;
+    }
+
+    if (!m_cv.wait_until(lock, deadline_time, [this] { return !m_busy; })) {
+        // the deadline thread discards the result once it arrives
+        lock.unlock();
+        apply_policy(input, output, nsamples);
+        return false;
+    }
+
+    // the launches failed; the next call rethrows the error
+    if (m_error) {
+        lock.unlock();
+        apply_policy(input, output, nsamples);
+        return false;
+    }
+
+    for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+        std::memcpy(output[ch], m_output_ptrs[ch], nsamples * sizeof(float));
+    }
+    if (m_config.policy == DeadlinePolicy::eHoldPrevious) {
+        m_held.resize(static_cast<size_t>(m_nchannels_out) * nsamples);
+        for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+            std::memcpy(m_held.data() + static_cast<size_t>(ch) * nsamples, m_output_ptrs[ch], nsamples * sizeof(float));
+        }
+        m_held_nsamples = nsamples;
+    }
+    return true;
+}
+
+void DeadlineExecutor::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_busy; });
+}
+
+uint64_t DeadlineExecutor::get_memory_footprint() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_input.capacity() + m_output.capacity() + m_held.capacity()) * sizeof(float) +
+        (m_input_ptrs.capacity() + m_output_ptrs.capacity()) * sizeof(float*);
+}
+
+void DeadlineExecutor::deadline_loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || m_posted; });
+        if (m_stop) {
+            return;
+        }
+        m_posted = false;
+
+        // the buffers belong to this thread while busy
+        lock.unlock();
+        std::exception_ptr error;
+        auto const start = std::chrono::steady_clock::now();
+        try {
+            m_process(m_input_ptrs.data(), m_output_ptrs.data(), m_nsamples);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        auto const duration = std::chrono::steady_clock::now() - start;
+        lock.lock();
+
+        if (error) {
+            m_error = error;
+        }
+        m_durations[m_nduration++ % m_durations.size()] = duration;
+
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+void DeadlineExecutor::post(float const* const* input, uint32_t nsamples) {
+    resize_buffers(nsamples);
+    for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+        std::memcpy(m_input.data() + static_cast<size_t>(ch) * m_capacity, input[ch], nsamples * sizeof(float));
+    }
+    m_nsamples = nsamples;
+    m_posted = true;
+    m_busy = true;
+    m_cv.notify_all();
+}
+
+std::chrono::steady_clock::duration DeadlineExecutor::predicted_duration() const {
+    auto const count = std::min<size_t>(m_nduration, m_durations.size());
+    if (count == 0u) {
+        return std::chrono::steady_clock::duration::zero();
+    }
+    // the median ignores a single slow launch but follows launches that became slow for good
+    auto durations = m_durations;
+    auto const median = durations.begin() + (count - 1u) / 2u;
+    std::nth_element(durations.begin(), median, durations.begin() + count);
+    return *median;
+}
+
+void DeadlineExecutor::resize_buffers(uint32_t nsamples) {
+    if (nsamples <= m_capacity) {
+        return;
+    }
+
+    m_capacity = nsamples;
+    m_input.resize(static_cast<size_t>(m_nchannels_in) * m_capacity);
+    m_output.resize(static_cast<size_t>(m_nchannels_out) * m_capacity);
+    for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+        m_input_ptrs[ch] = m_input.data() + static_cast<size_t>(ch) * m_capacity;
+    }
+    for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+        m_output_ptrs[ch] = m_output.data() + static_cast<size_t>(ch) * m_capacity;
+    }
+}
+
+void DeadlineExecutor::apply_policy(float const* const* input, float* const* output, uint32_t nsamples) const {
+    for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+        uint32_t ncopy {0u};
+        switch (m_config.policy) {
+        case DeadlinePolicy::ePassThrough:
+            if (ch < m_nchannels_in) {
+                ncopy = nsamples;
+                // input and output may be the same buffer
+                std::memmove(output[ch], input[ch], ncopy * sizeof(float));
+            }
+            break;
+        case DeadlinePolicy::eHoldPrevious:
+            ncopy = std::min(nsamples, m_held_nsamples);
+            if (ncopy != 0u) {
+                std::memcpy(output[ch], m_held.data() + static_cast<size_t>(ch) * m_held_nsamples, ncopy * sizeof(float));
+            }
+            break;
+        case DeadlinePolicy::eSilence:
+            break;
+        }
+        std::fill_n(output[ch] + ncopy, nsamples - ncopy, 0.f);
+    }
+}
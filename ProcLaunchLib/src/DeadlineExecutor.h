@@ -0,0 +1,121 @@
+#ifndef GPUA_DEADLINE_EXECUTOR_H
+#define GPUA_DEADLINE_EXECUTOR_H
+
+#include <ProcessorLauncherInterface.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs the launches of process() calls on a separate thread and answers calls that miss their deadline according to
+ * a DeadlinePolicy. At most one call is in flight; a call that finds its predecessor still running counts as missed.
+ * A call whose launches are predicted to take longer than the deadline, judging by the median of the recent launches,
+ * applies the policy right away; its launches still run s.t. the processors keep their state and the prediction
+ * follows the actual durations. The launches of a call that finds its predecessor still running never run, i.e., the
+ * processors never see that block.
+ */
+class DeadlineExecutor {
+public:
+    /**
+     * Performs the launches of a block on the deadline thread
+     */
+    using ProcessFunction = std::function<void(float const* const* input, float* const* output, uint32_t nsamples)>;
+
+    /**
+     * @brief Check that a deadline can be derived from the config
+     * @param config [in] deadline and policy
+     */
+    static void check_config(DeadlineConfig const& config);
+
+    /**
+     * @brief Constructor; starts the deadline thread
+     * @param nchannels_in [in] number of input channels
+     * @param nchannels_out [in] number of output channels
+     * @param config [in] deadline and policy
+     * @param process [in] performs the launches of a block
+     */
+    DeadlineExecutor(uint32_t nchannels_in, uint32_t nchannels_out, DeadlineConfig const& config, ProcessFunction process);
+
+    /**
+     * @brief Destructor; waits for a late block to finish and joins the deadline thread
+     */
+    ~DeadlineExecutor();
+
+    DeadlineExecutor(DeadlineExecutor const&) = delete;
+    DeadlineExecutor& operator=(DeadlineExecutor const&) = delete;
+
+    /**
+     * @brief Process a block within the deadline
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param output [in/out] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     * @return true if the deadline was met; otherwise, the output was written according to the policy. Launches that
+     * failed count as missed; their exception is rethrown by the next call.
+     */
+    bool process(float const* const* input, float* const* output, uint32_t nsamples);
+
+    /**
+     * @brief Get the deadline and policy the executor was created with
+     */
+    DeadlineConfig const& get_config() const {
+        return m_config;
+    }
+
+    /**
+     * @brief Wait until a late block finished
+     */
+    void wait_idle();
+
+    /**
+     * @brief Get the number of bytes of host memory held by the buffers of the executor
+     */
+    uint64_t get_memory_footprint();
+
+private:
+    void deadline_loop();
+    void resize_buffers(uint32_t nsamples);
+    void apply_policy(float const* const* input, float* const* output, uint32_t nsamples) const;
+    void post(float const* const* input, uint32_t nsamples);
+    std::chrono::steady_clock::duration predicted_duration() const;
+
+    uint32_t const m_nchannels_in;
+    uint32_t const m_nchannels_out;
+    DeadlineConfig const m_config;
+    ProcessFunction const m_process;
+
+    // blocks are copied in and out s.t. a late block never touches the caller's buffers
+    uint32_t m_capacity {0u};
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+    std::vector<float const*> m_input_ptrs;
+    std::vector<float*> m_output_ptrs;
+    uint32_t m_nsamples {0u};
+
+    // output of the last block that met its deadline; for DeadlinePolicy::eHoldPrevious
+    std::vector<float> m_held;
+    uint32_t m_held_nsamples {0u};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // a block was handed to the deadline thread and it did not pick it up yet
+    bool m_posted {false};
+    // a block was handed to the deadline thread and it did not finish it yet
+    bool m_busy {false};
+    bool m_stop {false};
+    // exception of a failed launch; rethrown by the next process() call
+    std::exception_ptr m_error;
+    // durations of the most recent launches; the prediction is their median
+    std::array<std::chrono::steady_clock::duration, 8> m_durations {};
+    uint32_t m_nduration {0u};
+
+    std::thread m_thread;
+};
+
+#endif // GPUA_DEADLINE_EXECUTOR_H
@@ -1,7 +1,69 @@
 #include <GPUCreate.h>
 
+#include "BlockCapture.h"
 #include "GPUProcessorLauncher.h"
+#include "LauncherSnapshot.h"
+#include "MappedFile.h"
+#include "ProcessingThread.h"
+#include "ProcessorLauncherFarm.h"
+#ifdef __linux__
+#include "SharedMemoryLauncher.h"
+#include "SharedMemoryServer.h"
+#endif
+#include "StreamingFrontEnd.h"
 
-std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel) {
-    return std::make_unique<GPUProcessorLauncher>(nchannels, nsamples_per_channel);
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel, ProcessingMode mode) {
+    return std::make_unique<GPUProcessorLauncher>(nchannels, nsamples_per_channel, mode);
 }
+
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix, ProcessingMode mode) {
+    return std::make_unique<GPUProcessorLauncher>(nchannels_in, nchannels_out, nsamples_per_channel, routing_matrix, mode);
+}
+
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncherFromSnapshot(char const* snapshot_path) {
+    // the processor specifications are read straight from the mapping; the launcher copies them while loading
+    MappedFile snapshot_file(snapshot_path);
+    LauncherSnapshot const snapshot = LauncherSnapshot::parse(snapshot_file.bytes());
+
+    auto launcher = std::make_unique<GPUProcessorLauncher>(snapshot.m_executor_config, snapshot.m_routing_matrix);
+    launcher->load_processors(snapshot.m_processors);
+    launcher->arm();
+    return launcher;
+}
+
+std::unique_ptr<CaptureReaderInterface> openCapture(char const* capture_path) {
+    return std::make_unique<CaptureReader>(capture_path);
+}
+
+std::unique_ptr<ProcessorLauncherFarmInterface> createProcessorLauncherFarm(uint32_t nworkers) {
+    return std::make_unique<ProcessorLauncherFarm>(nworkers);
+}
+
+std::unique_ptr<StreamingFrontEndInterface> createStreamingFrontEnd(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t block_size, uint32_t safety_margin) {
+    return std::make_unique<StreamingFrontEnd>(std::move(launcher), nchannels_in, nchannels_out, block_size, safety_margin);
+}
+
+void setProcessingThreadConfig(ThreadConfig const& config) {
+    set_processing_thread_config(config);
+}
+
+ThreadReport applyThreadConfig(ThreadConfig const& config, char const* name) {
+    return apply_thread_config(config, name ? name : "");
+}
+
+std::vector<ThreadReport> getProcessingThreadReports() {
+    return get_processing_thread_reports();
+}
+
+#ifdef __linux__
+std::unique_ptr<ProcessingServerInterface> createProcessingServer(char const* socket_path, char const* capture_directory) {
+    return std::make_unique<SharedMemoryServer>(socket_path, capture_directory);
+}
+
+std::unique_ptr<SharedMemoryLauncherInterface> createSharedMemoryLauncher(char const* socket_path, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix, ProcessingMode mode) {
+    // same configuration as a local launcher; with a routing matrix, the chain keeps the input channels
+    ProcessExecutorConfig const executor_config = GPUProcessorLauncher::make_executor_config(nchannels_in, routing_matrix ? nchannels_in : nchannels_out, nsamples_per_channel, mode);
+    std::vector<float> matrix = routing_matrix ? std::vector<float>(routing_matrix, routing_matrix + static_cast<size_t>(nchannels_out) * nchannels_in) : std::vector<float> {};
+    return std::make_unique<SharedMemoryLauncher>(socket_path, executor_config, std::move(matrix));
+}
+#endif
@@ -6,6 +6,10 @@
 #include <engine_api/LauncherSpecification.h>
 #include <engine_api/ModuleInfo.h>
 
+#include "ProcessingThread.h"
+#include "ProcessorTails.h"
+#include "SilenceDetection.h"
+
 #define _USE_MATH_DEFINES
 #include <algorithm>
 #include <array>
@@ -13,18 +17,49 @@
 #include <math.h>
 #include <chrono>
 #include <cmath>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
-GPUProcessorLauncher::GPUProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel) :
-    m_nchannels {nchannels} {
-    // buffer settings and double buffering configuration (see `gpu_audio_client` for details)
-    m_executor_config = {
-        .retain_threshold = 0.625,
-        .launch_threshold = 0.7275,
-        .nchannels_in = m_nchannels,
-        .nchannels_out = m_nchannels,
-        .max_samples_per_channel = nsamples_per_channel};
+namespace {
+// positions of the modules in the module provider by id; all launchers of the process see the same modules, so they
+// are scanned once for all of them
+std::mutex g_module_index_mutex;
+std::map<std::wstring, uint32_t> g_module_index;
+} // namespace
+
+GPUProcessorLauncher::GPUProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel, ProcessingMode mode) :
+    GPUProcessorLauncher(make_executor_config(nchannels, nchannels, nsamples_per_channel, mode)) {
+}
+
+GPUProcessorLauncher::GPUProcessorLauncher(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix, ProcessingMode mode) :
+    // with a routing matrix, the chain keeps the input channels and the matrix maps them to the output channels
+    GPUProcessorLauncher(make_executor_config(nchannels_in, routing_matrix ? nchannels_in : nchannels_out, nsamples_per_channel, mode),
+        routing_matrix ? std::vector<float>(routing_matrix, routing_matrix + static_cast<size_t>(nchannels_out) * nchannels_in) : std::vector<float> {}) {
+}
+
+GPUProcessorLauncher::GPUProcessorLauncher(ProcessExecutorConfig const& executor_config, std::vector<float> routing_matrix) :
+    m_nchannels_in {executor_config.nchannels_in},
+    m_nchannels_out {routing_matrix.empty() ? executor_config.nchannels_out : static_cast<uint32_t>(routing_matrix.size() / std::max(executor_config.nchannels_in, 1u))},
+    m_executor_config {executor_config},
+    m_routing_matrix {std::move(routing_matrix)},
+    m_launch_in(m_nchannels_in),
+    m_launch_out(m_nchannels_out),
+    m_channel_mask(m_nchannels_in, m_nchannels_out, m_routing_matrix.empty()) {
+    if (!m_routing_matrix.empty()) {
+        if (m_executor_config.nchannels_out != m_nchannels_in || m_routing_matrix.size() != static_cast<size_t>(m_nchannels_out) * m_nchannels_in) {
+            throw std::runtime_error("Routing matrix does not match the channel configuration");
+        }
+        // the chain's output is routed from a scratch buffer to the caller's output channels
+        m_chain_out.resize(static_cast<size_t>(m_nchannels_in) * m_executor_config.max_samples_per_channel);
+        m_chain_out_ptrs.resize(m_nchannels_in);
+        for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+            m_chain_out_ptrs[ch] = m_chain_out.data() + static_cast<size_t>(ch) * m_executor_config.max_samples_per_channel;
+        }
+    }
 
     // create gpu_audio engine and make sure a supported GPU is installed/selected
     const auto& gpu_audio = GpuAudioManager::GetGpuAudio();
@@ -51,7 +86,28 @@ GPUProcessorLauncher::GPUProcessorLauncher(uint32_t nchannels, uint32_t nsamples
     }
 };
 
+ProcessExecutorConfig GPUProcessorLauncher::make_executor_config(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, ProcessingMode mode) {
+    // buffer settings and double buffering configuration (see `gpu_audio_client` for details)
+    if (mode == ProcessingMode::eOffline) {
+        // nobody waits for an individual launch; launch the largest efficient buffers back-to-back
+        return {
+            .retain_threshold = 1.0,
+            .launch_threshold = 1.0,
+            .nchannels_in = nchannels_in,
+            .nchannels_out = nchannels_out,
+            .max_samples_per_channel = std::max(nsamples_per_channel, MaxSampleCount)};
+    }
+    return {
+        .retain_threshold = 0.625,
+        .launch_threshold = 0.7275,
+        .nchannels_in = nchannels_in,
+        .nchannels_out = nchannels_out,
+        .max_samples_per_channel = nsamples_per_channel};
+}
+
 GPUProcessorLauncher::~GPUProcessorLauncher() {
+    // wait for a late launch and stop the deadline thread
+    m_deadline_executor.reset();
     // delete executor and processor
     disarm();
     // delete the processing graph
@@ -64,6 +120,13 @@ void GPUProcessorLauncher::arm() {
     std::lock_guard<std::mutex> lock(m_armed_mutex);
 
     if (!m_armed) {
+        if (m_memory_budget != 0u) {
+            uint64_t const footprint = get_memory_footprint().total();
+            if (footprint > m_memory_budget) {
+                throw std::runtime_error("Memory footprint of " + std::to_string(footprint) + " bytes exceeds the budget of " + std::to_string(m_memory_budget) + " bytes");
+            }
+        }
+
         thread_local std::vector<GPUA::engine::v2::Processor*> processors;
         processors.clear();
         for (auto& p_desc : m_processors) {
@@ -79,6 +142,9 @@ void GPUProcessorLauncher::arm() {
             }
             processors.emplace_back(p_desc.m_processor);
         }
+        // freshly created processors have no tail yet, so leading silence can be skipped right away
+        m_tail_samples = std::accumulate(m_processors.begin(), m_processors.end(), uint64_t {0u}, [](uint64_t sum, ProcDesc const& p_desc) { return sum + p_desc.m_tail_samples; });
+        m_silent_samples = m_tail_samples;
         // create an executor that manages input and output buffers and performs the actual launches
         m_process_executor = new ProcessExecutor<ExecutionMode::eSync>(m_launcher, m_graph, static_cast<uint32_t>(processors.size()), processors.data(), m_executor_config);
         m_armed = true;
@@ -89,6 +155,11 @@ void GPUProcessorLauncher::disarm() {
     std::lock_guard<std::mutex> lock(m_armed_mutex);
 
     if (m_armed) {
+        // a late launch on the deadline thread still uses the executor
+        if (m_deadline_executor) {
+            m_deadline_executor->wait_idle();
+        }
+
         // delete the executor. ensures that all launches have finished before destroying itself.
         if (m_process_executor) {
             delete m_process_executor;
@@ -104,75 +175,460 @@ void GPUProcessorLauncher::disarm() {
     m_armed = false;
 }
 
+double GPUProcessorLauncher::warm_up(uint32_t nblocks) {
+    if (!m_armed) {
+        arm();
+    }
+
+    uint32_t const nsamples = m_executor_config.max_samples_per_channel;
+    std::vector<float> silence(static_cast<size_t>(m_executor_config.nchannels_in) * nsamples, 0.f);
+    std::vector<float> output(static_cast<size_t>(m_executor_config.nchannels_out) * nsamples);
+    std::vector<float const*> silence_ptrs(m_executor_config.nchannels_in);
+    std::vector<float*> output_ptrs(m_executor_config.nchannels_out);
+    for (uint32_t ch {0u}; ch < m_executor_config.nchannels_in; ++ch) {
+        silence_ptrs[ch] = silence.data() + static_cast<size_t>(ch) * nsamples;
+    }
+    for (uint32_t ch {0u}; ch < m_executor_config.nchannels_out; ++ch) {
+        output_ptrs[ch] = output.data() + static_cast<size_t>(ch) * nsamples;
+    }
+
+    // launch directly; silence skipping, the deadline, the capture and the statistics don't apply to warm-up launches
+    std::vector<double> durations_us(nblocks);
+    for (double& duration_us : durations_us) {
+        auto const start = std::chrono::steady_clock::now();
+        m_process_executor->template Execute<AudioDataLayout::eChannelsIndividual>(nsamples, silence_ptrs.data(), output_ptrs.data());
+        duration_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // the first real block starts from freshly created processors, whatever state the warm-up launches left behind
+    reset_processors();
+
+    if (durations_us.empty()) {
+        return 0.0;
+    }
+    // the first launches include one-time setup; the median reflects the steady state
+    std::nth_element(durations_us.begin(), durations_us.begin() + durations_us.size() / 2u, durations_us.end());
+    return durations_us[durations_us.size() / 2u];
+}
+
 void GPUProcessorLauncher::process(float const* const* in_buffer, float* const* out_buffer, int nsamples) {
     // If the GPUProcessorLauncher was not armed ahead of time, arm it on the first process call.
     if (!m_armed) {
         arm();
     }
 
-    thread_local std::vector<float const*> input_ptrs;
-    thread_local std::vector<float*> output_ptrs;
-    // If we have to perform multiple launches, we have to copy the channel pointers s.t. we can advance them.
-    if (nsamples > m_executor_config.max_samples_per_channel) {
-        input_ptrs.assign(in_buffer, in_buffer + m_nchannels);
-        output_ptrs.assign(out_buffer, out_buffer + m_nchannels);
+    uint32_t const total_samples = static_cast<uint32_t>(std::max(nsamples, 0));
+    // record before processing; in place, the output overwrites the input
+    if (m_recorder) {
+        m_recorder->record(in_buffer, total_samples, nullptr);
+    }
+    if (m_reset_pending) {
+        reset_processors();
+    }
+    process_block(in_buffer, out_buffer, total_samples);
+}
+
+void GPUProcessorLauncher::reset_processors() {
+    disarm();
+    arm();
+    m_reset_pending = false;
+}
+
+void GPUProcessorLauncher::process_block(float const* const* in_buffer, float* const* out_buffer, uint32_t total_samples) {
+    if (m_deadline_executor) {
+        if (!m_deadline_executor->process(in_buffer, out_buffer, total_samples)) {
+            m_deadline_misses.fetch_add(1u, std::memory_order_relaxed);
+        }
+        return;
+    }
+    process_launches(in_buffer, out_buffer, total_samples);
+}
+
+void GPUProcessorLauncher::render_segmented(float const* const* input, float* const* output, uint32_t nsamples, uint32_t nsegments) {
+    if (nsegments == 0u) {
+        nsegments = std::max(1u, std::thread::hardware_concurrency());
+    }
+    nsegments = std::min(nsegments, MaxRenderSegments);
+
+    std::vector<std::unique_ptr<GPUProcessorLauncher>> segment_launchers;
+    uint64_t preroll {0u};
+    {
+        std::lock_guard<std::mutex> lock(m_armed_mutex);
+        preroll = std::accumulate(m_processors.begin(), m_processors.end(), uint64_t {0u}, [](uint64_t sum, ProcDesc const& p_desc) { return sum + p_desc.m_tail_samples; });
+
+        // a segment shorter than its pre-roll or than one launch costs more than it saves
+        uint64_t const min_segment_samples = std::max<uint64_t>({preroll, m_executor_config.max_samples_per_channel, 1u});
+        nsegments = static_cast<uint32_t>(std::clamp<uint64_t>(nsamples / min_segment_samples, 1u, nsegments));
+
+        // without the tail, the pre-roll can't bring the processors' state to the segment boundary
+        if (nsegments > 1u && std::any_of(m_processors.begin(), m_processors.end(), [](ProcDesc const& p_desc) { return !p_desc.m_tail_known; })) {
+            throw std::runtime_error("Error GPUProcessorLauncher::render_segmented called with a processor of unknown tail; declare its tail in load_processor");
+        }
+
+        LauncherSnapshot const snapshot = make_snapshot();
+        for (uint32_t seg {0u}; seg < nsegments; ++seg) {
+            auto& segment_launcher = segment_launchers.emplace_back(std::make_unique<GPUProcessorLauncher>(m_executor_config, m_routing_matrix));
+            segment_launcher->load_processors(snapshot.m_processors);
+            segment_launcher->set_silence_skipping(m_skip_silence, m_silence_threshold);
+        }
+    }
+
+    // segment boundaries; segment `seg` renders [begin[seg], begin[seg + 1])
+    std::vector<uint32_t> begin(nsegments + 1u);
+    for (uint32_t seg {0u}; seg <= nsegments; ++seg) {
+        begin[seg] = static_cast<uint32_t>(static_cast<uint64_t>(nsamples) * seg / nsegments);
+    }
+
+    // copy the pre-roll input before any segment starts; in place, the previous segment overwrites it. The pre-roll is
+    // processed in place and its output discarded, so each segment gets max(nchannels_in, nchannels_out) channels.
+    uint32_t const preroll_channels = std::max(m_nchannels_in, m_nchannels_out);
+    std::vector<uint32_t> preroll_samples(nsegments, 0u);
+    std::vector<std::vector<float>> preroll_data(nsegments);
+    std::vector<std::vector<float*>> preroll_ptrs(nsegments, std::vector<float*>(preroll_channels));
+    for (uint32_t seg {1u}; seg < nsegments; ++seg) {
+        preroll_samples[seg] = static_cast<uint32_t>(std::min<uint64_t>(preroll, begin[seg]));
+        preroll_data[seg].assign(static_cast<size_t>(preroll_channels) * preroll_samples[seg], 0.f);
+        for (uint32_t ch {0u}; ch < preroll_channels; ++ch) {
+            preroll_ptrs[seg][ch] = preroll_data[seg].data() + static_cast<size_t>(ch) * preroll_samples[seg];
+        }
+        for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+            std::copy_n(input[ch] + begin[seg] - preroll_samples[seg], preroll_samples[seg], preroll_ptrs[seg][ch]);
+        }
+    }
+
+    std::vector<std::exception_ptr> errors(nsegments);
+    auto render_segment = [&](uint32_t seg) {
+        try {
+            GPUProcessorLauncher& segment_launcher = *segment_launchers[seg];
+            segment_launcher.arm();
+            if (preroll_samples[seg] != 0u) {
+                segment_launcher.process(preroll_ptrs[seg].data(), preroll_ptrs[seg].data(), static_cast<int>(preroll_samples[seg]));
+            }
+
+            std::vector<float const*> segment_in(m_nchannels_in);
+            std::vector<float*> segment_out(m_nchannels_out);
+            for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+                segment_in[ch] = input[ch] + begin[seg];
+            }
+            for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+                segment_out[ch] = output[ch] + begin[seg];
+            }
+            segment_launcher.process(segment_in.data(), segment_out.data(), static_cast<int>(begin[seg + 1u] - begin[seg]));
+        }
+        catch (...) {
+            errors[seg] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nsegments - 1u);
+    try {
+        for (uint32_t seg {1u}; seg < nsegments; ++seg) {
+            threads.emplace_back(start_processing_thread("gpua-segment-" + std::to_string(seg), [&render_segment, seg] { render_segment(seg); }));
+        }
+    }
+    catch (...) {
+        // the segments that started still use this frame
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    render_segment(0u);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto const& segment_launcher : segment_launchers) {
+        LauncherStatistics const stats = segment_launcher->get_statistics();
+        m_launches.fetch_add(stats.launches, std::memory_order_relaxed);
+        m_skipped_launches.fetch_add(stats.skipped_launches, std::memory_order_relaxed);
+    }
+    for (auto const& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void GPUProcessorLauncher::process(float const* const* in_buffer, float* const* out_buffer, int nsamples, uint8_t const* active_channels) {
+    if (!active_channels) {
+        process(in_buffer, out_buffer, nsamples);
+        return;
     }
 
-    uint32_t remaining_samples = nsamples;
-    while (remaining_samples != 0) {
+    if (!m_armed) {
+        arm();
+    }
+
+    uint32_t const total_samples = static_cast<uint32_t>(std::max(nsamples, 0));
+    // the mask is recorded with the unmasked input s.t. a replay applies the inactive channel output as well
+    if (m_recorder) {
+        m_recorder->record(in_buffer, total_samples, active_channels);
+    }
+    bool const any_active = m_channel_mask.prepare(in_buffer, out_buffer, total_samples, active_channels);
+    if (any_active) {
+        if (m_reset_pending) {
+            reset_processors();
+        }
+        process_block(m_channel_mask.input(), m_channel_mask.output(), total_samples);
+    }
+    else {
+        // nothing to process; the processors keep their state or are recreated once channels become active again
+        uint32_t const max_samples = m_executor_config.max_samples_per_channel;
+        m_skipped_launches.fetch_add((total_samples + max_samples - 1u) / max_samples, std::memory_order_relaxed);
+        m_reset_pending |= m_inactive_state == InactiveChannelState::eReset;
+    }
+    m_channel_mask.finish(out_buffer, total_samples, active_channels, !any_active, m_inactive_output);
+}
+
+void GPUProcessorLauncher::set_inactive_channel_output(InactiveChannelOutput policy) {
+    m_inactive_output = policy;
+}
+
+void GPUProcessorLauncher::set_inactive_channel_state(InactiveChannelState policy) {
+    m_inactive_state = policy;
+}
+
+void GPUProcessorLauncher::process_launches(float const* const* in_buffer, float* const* out_buffer, uint32_t total_samples) {
+    for (uint32_t offset {0u}; offset < total_samples;) {
         // determine the number of samples for this launch
-        uint32_t this_launch_samples = std::min(m_executor_config.max_samples_per_channel, remaining_samples);
-        // process samples [i, i + this_launch_samples)
-        m_process_executor->template Execute<AudioDataLayout::eChannelsIndividual>(this_launch_samples, in_buffer, out_buffer);
+        uint32_t this_launch_samples = std::min(m_executor_config.max_samples_per_channel, total_samples - offset);
+
+        // all but the first launch address the channels at an offset; the caller's pointer arrays stay untouched
+        float const* const* launch_in = in_buffer;
+        float* const* launch_out = out_buffer;
+        if (offset != 0u) {
+            for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+                m_launch_in[ch] = in_buffer[ch] + offset;
+            }
+            for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+                m_launch_out[ch] = out_buffer[ch] + offset;
+            }
+            launch_in = m_launch_in.data();
+            launch_out = m_launch_out.data();
+        }
+
+        // write silence instead of launching if the input is silent and the tail of the chain has decayed
+        bool skip_launch {false};
+        if (m_skip_silence) {
+            if (is_silent(launch_in, m_nchannels_in, this_launch_samples, m_silence_threshold)) {
+                skip_launch = m_silent_samples >= m_tail_samples;
+                m_silent_samples += this_launch_samples;
+            }
+            else {
+                m_silent_samples = 0u;
+            }
+        }
+
+        if (skip_launch) {
+            for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+                std::fill_n(launch_out[ch], this_launch_samples, 0.f);
+            }
+            m_skipped_launches.fetch_add(1u, std::memory_order_relaxed);
+        }
+        else {
+            // process samples [offset, offset + this_launch_samples). in place is safe: the executor copies the input
+            // into its buffers before it writes any output, and later launches only read samples that were not written yet
+            if (m_routing_matrix.empty()) {
+                m_process_executor->template Execute<AudioDataLayout::eChannelsIndividual>(this_launch_samples, launch_in, launch_out);
+            }
+            else {
+                m_process_executor->template Execute<AudioDataLayout::eChannelsIndividual>(this_launch_samples, launch_in, m_chain_out_ptrs.data());
+                route(launch_out, this_launch_samples);
+            }
+            m_launches.fetch_add(1u, std::memory_order_relaxed);
+        }
 
-        // advance channel pointers for the next iteration if required
-        remaining_samples -= this_launch_samples;
-        if (remaining_samples != 0) {
-            for (auto& ptr : input_ptrs)
-                ptr += this_launch_samples;
-            in_buffer = input_ptrs.data();
+        offset += this_launch_samples;
+    }
+}
 
-            for (auto& ptr : output_ptrs)
-                ptr += this_launch_samples;
-            out_buffer = output_ptrs.data();
+void GPUProcessorLauncher::route(float* const* out_buffer, uint32_t nsamples) const {
+    // out[o] = sum_i matrix[o][i] * chain_out[i]
+    for (uint32_t o_ch {0u}; o_ch < m_nchannels_out; ++o_ch) {
+        float* out = out_buffer[o_ch];
+        float const* gains = m_routing_matrix.data() + static_cast<size_t>(o_ch) * m_nchannels_in;
+        std::fill_n(out, nsamples, 0.f);
+        for (uint32_t i_ch {0u}; i_ch < m_nchannels_in; ++i_ch) {
+            float const gain = gains[i_ch];
+            if (gain == 0.f) {
+                continue;
+            }
+            float const* in = m_chain_out_ptrs[i_ch];
+            for (uint32_t s {0u}; s < nsamples; ++s) {
+                out[s] += gain * in[s];
+            }
         }
     }
 }
 
-void GPUProcessorLauncher::load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size) {
+void GPUProcessorLauncher::load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size, uint32_t tail_samples) {
     std::lock_guard<std::mutex> lock(m_armed_mutex);
     if (m_armed) {
         throw std::runtime_error("Error GPUProcessorLauncher::load_processor called while armed");
     }
 
-    // add a descriptor for the processor that's to be loaded
-    ProcDesc& p_desc = m_processors.emplace_back();
+    add_processor(p_id, reinterpret_cast<std::byte const*>(p_data), p_data_size, tail_samples);
+}
+
+void GPUProcessorLauncher::load_processors(std::vector<LauncherSnapshot::ProcessorEntry> const& processors) {
+    std::lock_guard<std::mutex> lock(m_armed_mutex);
+    if (m_armed) {
+        throw std::runtime_error("Error GPUProcessorLauncher::load_processors called while armed");
+    }
+
+    size_t const nprocessors_before = m_processors.size();
+    try {
+        for (auto const& entry : processors) {
+            add_processor(entry.m_module_id, entry.m_spec.data(), static_cast<uint32_t>(entry.m_spec.size()), entry.m_tail_samples);
+        }
+    }
+    catch (...) {
+        // don't leave a partially loaded chain behind
+        m_processors.resize(nprocessors_before);
+        throw;
+    }
+}
 
+void GPUProcessorLauncher::save_snapshot(char const* snapshot_path) {
+    std::lock_guard<std::mutex> lock(m_armed_mutex);
+    make_snapshot().write(snapshot_path);
+}
+
+void GPUProcessorLauncher::start_capture(char const* capture_path) {
+    std::lock_guard<std::mutex> lock(m_armed_mutex);
+    // a running capture is closed before the new file is created
+    m_recorder.reset();
+    CaptureSettings const settings {
+        .skip_silence = m_skip_silence,
+        .silence_threshold = m_silence_threshold,
+        .has_deadline = m_deadline_executor != nullptr,
+        .deadline = m_deadline_executor ? m_deadline_executor->get_config() : DeadlineConfig {},
+        .inactive_output = m_inactive_output,
+        .inactive_state = m_inactive_state};
+    m_recorder = std::make_unique<BlockRecorder>(capture_path, make_snapshot(), settings);
+}
+
+void GPUProcessorLauncher::stop_capture() {
+    if (m_recorder) {
+        std::unique_ptr<BlockRecorder> recorder = std::move(m_recorder);
+        recorder->finish();
+    }
+}
+
+LauncherSnapshot GPUProcessorLauncher::make_snapshot() const {
+    LauncherSnapshot snapshot {.m_executor_config = m_executor_config, .m_routing_matrix = m_routing_matrix};
+    snapshot.m_processors.reserve(m_processors.size());
+    for (auto const& p_desc : m_processors) {
+        snapshot.m_processors.push_back({.m_module_id = p_desc.m_module_id, .m_spec = p_desc.m_processor_spec, .m_tail_samples = p_desc.m_tail_samples});
+    }
+    return snapshot;
+}
+
+void GPUProcessorLauncher::set_silence_skipping(bool enable, float threshold) {
+    m_skip_silence = enable;
+    m_silence_threshold = threshold;
+}
+
+void GPUProcessorLauncher::set_deadline(DeadlineConfig const& config) {
+    // an invalid config leaves the current deadline in place
+    DeadlineExecutor::check_config(config);
+    // a late launch of the previous deadline executor finishes before the new one takes over
+    m_deadline_executor.reset();
+    m_deadline_executor = std::make_unique<DeadlineExecutor>(m_nchannels_in, m_nchannels_out, config, [this](float const* const* input, float* const* output, uint32_t nsamples) {
+        process_launches(input, output, nsamples);
+    });
+}
+
+void GPUProcessorLauncher::clear_deadline() {
+    m_deadline_executor.reset();
+}
+
+LauncherStatistics GPUProcessorLauncher::get_statistics() const {
+    return {
+        .launches = m_launches.load(std::memory_order_relaxed),
+        .skipped_launches = m_skipped_launches.load(std::memory_order_relaxed),
+        .deadline_misses = m_deadline_misses.load(std::memory_order_relaxed)};
+}
+
+MemoryFootprint GPUProcessorLauncher::get_memory_footprint() const {
+    MemoryFootprint footprint {};
+    for (auto const& p_desc : m_processors) {
+        footprint.processor_specs += p_desc.m_processor_spec.capacity();
+    }
+
+    // the executor allocates its buffers when armed; they are not exposed, so estimate them from the configuration
+    uint64_t const executor_samples = static_cast<uint64_t>(m_executor_config.nchannels_in + m_executor_config.nchannels_out) * m_executor_config.max_samples_per_channel;
+    footprint.executor_buffers = 2u * executor_samples * sizeof(float);
+
+    footprint.scratch = m_chain_out.capacity() * sizeof(float) +
+        (m_chain_out_ptrs.capacity() + m_launch_in.capacity() + m_launch_out.capacity()) * sizeof(float*);
+    footprint.scratch += m_channel_mask.memory_footprint();
+    if (m_recorder) {
+        footprint.scratch += m_recorder->get_memory_footprint();
+    }
+
+    if (m_deadline_executor) {
+        footprint.deadline_buffers = m_deadline_executor->get_memory_footprint();
+    }
+    return footprint;
+}
+
+void GPUProcessorLauncher::set_memory_budget(uint64_t budget_bytes) {
+    m_memory_budget = budget_bytes;
+}
+
+GPUA::engine::v2::Module* GPUProcessorLauncher::find_module(std::wstring const& p_id) {
     // get the module provider from the launcher to access all available modules (read as processors here)
     auto& module_provider = m_launcher->GetModuleProvider();
-    const auto module_count = module_provider.GetModulesCount();
+
     GPUA::engine::v2::ModuleInfo info {};
-    bool processor_module_found = false;
-    // iterate the module infos and try to find the requested processor by matching the id
-    for (uint32_t i = 0; i < module_count; ++i) {
-        if ((module_provider.GetModuleInfo(i, info) == GPUA::engine::v2::ErrorCode::eSuccess) && info.id && (std::wcscmp(info.id, p_id) == 0)) {
-            processor_module_found = true;
-            break;
+    {
+        std::lock_guard<std::mutex> lock(g_module_index_mutex);
+        auto const lookup = [&module_provider, &p_id, &info](uint32_t position) {
+            return module_provider.GetModuleInfo(position, info) == GPUA::engine::v2::ErrorCode::eSuccess && info.id && p_id == info.id;
+        };
+
+        // iterate the module infos once and index them by id for all following lookups of all launchers
+        auto it = g_module_index.find(p_id);
+        if (it == g_module_index.end() || !lookup(it->second)) {
+            g_module_index.clear();
+            const auto module_count = module_provider.GetModulesCount();
+            for (uint32_t i = 0; i < module_count; ++i) {
+                GPUA::engine::v2::ModuleInfo scanned {};
+                if ((module_provider.GetModuleInfo(i, scanned) == GPUA::engine::v2::ErrorCode::eSuccess) && scanned.id) {
+                    g_module_index.emplace(scanned.id, i);
+                }
+            }
+            it = g_module_index.find(p_id);
+            // we could not find the processor
+            if (it == g_module_index.end() || !lookup(it->second)) {
+                throw std::runtime_error("Failed to find required processor module");
+            }
         }
     }
-    // we could not find the processor
-    if (!processor_module_found) {
-        m_processors.pop_back();
-        throw std::runtime_error("Failed to find required processor module");
-    }
 
     // get the processor's module; we need this to create and destroy the processor instance
-    if ((module_provider.GetModule(info, p_desc.m_module) != GPUA::engine::v2::ErrorCode::eSuccess) || !p_desc.m_module) {
-        m_processors.pop_back();
+    GPUA::engine::v2::Module* module {nullptr};
+    if ((module_provider.GetModule(info, module) != GPUA::engine::v2::ErrorCode::eSuccess) || !module) {
         throw std::runtime_error("Failed to load required processor module");
     }
+    return module;
+}
+
+void GPUProcessorLauncher::add_processor(std::wstring const& p_id, std::byte const* p_data, uint32_t p_data_size, uint32_t tail_samples) {
+    GPUA::engine::v2::Module* module = find_module(p_id);
+
+    // add a descriptor for the processor that's to be loaded
+    ProcDesc& p_desc = m_processors.emplace_back();
+    p_desc.m_module_id = p_id;
+    p_desc.m_module = module;
+    // a declared tail may extend the tail derived from the specification but not shorten it
+    std::optional<uint32_t> const derived_tail = derive_tail_samples(p_id, std::span<std::byte const>(p_data, p_data_size));
+    p_desc.m_tail_samples = std::max(tail_samples, derived_tail.value_or(0u));
+    p_desc.m_tail_known = derived_tail.has_value() || tail_samples != 0u;
 
     // create a local copy of the provided specification to guarantee it is still available when we (re-)create the processor
-    std::byte const* p_data_bytes = reinterpret_cast<std::byte const*>(p_data);
-    p_desc.m_processor_spec.assign(p_data_bytes, p_data_bytes + p_data_size);
+    p_desc.m_processor_spec.assign(p_data, p_data + p_data_size);
 }
@@ -10,10 +10,16 @@
 
 #include <gpu_audio_client/ProcessExecutorSync.h>
 
+#include "BlockCapture.h"
+#include "ChannelMask.h"
+#include "DeadlineExecutor.h"
+#include "LauncherSnapshot.h"
+
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <deque>
-#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -27,8 +33,26 @@ public:
      * @brief Constructor
      * @param nchannels [in] number of channels of the audio data to process
      * @param nsamples_per_channel [in] maximum number of samples per channel in the processing-buffer
+     * @param mode [in] real-time or offline processing; offline launches at least MaxSampleCount samples per channel
+     */
+    GPUProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel, ProcessingMode mode = ProcessingMode::eRealtime);
+
+    /**
+     * @brief Constructor
+     * @param nchannels_in [in] number of channels of the input audio data
+     * @param nchannels_out [in] number of channels of the output audio data
+     * @param nsamples_per_channel [in] maximum number of samples per channel in the processing-buffer
+     * @param routing_matrix [in] optional nchannels_out x nchannels_in row-major matrix that maps the chain's output to the output channels
+     * @param mode [in] real-time or offline processing; offline launches at least MaxSampleCount samples per channel
      */
-    GPUProcessorLauncher(uint32_t nchannels, uint32_t nsamples_per_channel);
+    GPUProcessorLauncher(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix, ProcessingMode mode = ProcessingMode::eRealtime);
+
+    /**
+     * @brief Constructor
+     * @param executor_config [in] buffer settings and double buffering configuration of the executor
+     * @param routing_matrix [in] optional row-major matrix that maps the chain's nchannels_in output channels to the output channels
+     */
+    explicit GPUProcessorLauncher(ProcessExecutorConfig const& executor_config, std::vector<float> routing_matrix = {});
 
     /**
      * @brief Destructor
@@ -39,18 +63,83 @@ public:
     // ProcessorLauncherInterface methods
     virtual void arm() override;
     virtual void disarm() override;
+    virtual double warm_up(uint32_t nblocks) override;
     virtual void process(float const* const* in_buffer, float* const* out_buffer, int nsamples) override;
+    virtual void process(float const* const* in_buffer, float* const* out_buffer, int nsamples, uint8_t const* active_channels) override;
+    virtual void set_inactive_channel_output(InactiveChannelOutput policy) override;
+    virtual void set_inactive_channel_state(InactiveChannelState policy) override;
+    virtual void render_segmented(float const* const* input, float* const* output, uint32_t nsamples, uint32_t nsegments) override;
 
-    virtual void load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size) override;
+    virtual void load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size, uint32_t tail_samples) override;
+    virtual void save_snapshot(char const* snapshot_path) override;
+    virtual void start_capture(char const* capture_path) override;
+    virtual void stop_capture() override;
+    virtual void set_silence_skipping(bool enable, float threshold) override;
+    virtual void set_deadline(DeadlineConfig const& config) override;
+    virtual void clear_deadline() override;
+    virtual LauncherStatistics get_statistics() const override;
+    virtual MemoryFootprint get_memory_footprint() const override;
+    virtual void set_memory_budget(uint64_t budget_bytes) override;
     // ProcessorLauncherInterface methods
     ////////////////////////////////
 
+    /**
+     * @brief Load all processors of a snapshot into the launcher; either all or none of them are loaded
+     * @param processors [in] ordered list of processors to load
+     */
+    void load_processors(std::vector<LauncherSnapshot::ProcessorEntry> const& processors);
+
+    /**
+     * @brief Recreate the processors of an armed launcher s.t. the next block starts from their initial state
+     */
+    void reset_processors();
+
+    /**
+     * @brief Get the executor configuration for the given processing mode
+     */
+    static ProcessExecutorConfig make_executor_config(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, ProcessingMode mode);
+
 private:
+    /**
+     * @brief Process a block on the deadline thread if there is a deadline, otherwise directly. The launcher must be armed.
+     */
+    void process_block(float const* const* in_buffer, float* const* out_buffer, uint32_t total_samples);
+
+    /**
+     * @brief Process samples in launches of at most max_samples_per_channel samples. The launcher must be armed.
+     */
+    void process_launches(float const* const* in_buffer, float* const* out_buffer, uint32_t nsamples);
+
+    /**
+     * @brief Get a snapshot of the configuration and the loaded processors. Must be called with m_armed_mutex held.
+     */
+    LauncherSnapshot make_snapshot() const;
+
+    /**
+     * @brief Mix the chain's output into the output channels according to the routing matrix
+     */
+    void route(float* const* out_buffer, uint32_t nsamples) const;
+
+    /**
+     * @brief Find a processor module by its id. Must be called with m_armed_mutex held.
+     * @param p_id [in] unique identifier of the processor module
+     * @return the module; throws if it can't be found or loaded
+     */
+    GPUA::engine::v2::Module* find_module(std::wstring const& p_id);
+
+    /**
+     * @brief Add a processor descriptor for the given module and specification. Must be called with m_armed_mutex held.
+     */
+    void add_processor(std::wstring const& p_id, std::byte const* p_data, uint32_t p_data_size, uint32_t tail_samples);
+
     std::mutex m_armed_mutex;
     bool m_armed {false};
 
-    uint32_t const m_nchannels;
+    uint32_t const m_nchannels_in;
+    uint32_t const m_nchannels_out;
     static constexpr uint32_t MaxSampleCount {4096u};
+    // every segment of render_segmented creates its own processors and executor
+    static constexpr uint32_t MaxRenderSegments {8u};
 
     GPUA::engine::v2::GraphLauncher* m_launcher {nullptr};
     GPUA::engine::v2::ProcessingGraph* m_graph {nullptr};
@@ -59,8 +148,12 @@ private:
      * Contains everything required to create/delete a processor instance
      */
     struct ProcDesc {
+        std::wstring m_module_id;
         GPUA::engine::v2::Module* m_module {nullptr};
         std::vector<std::byte> m_processor_spec;
+        uint32_t m_tail_samples {0u};
+        // the tail was derived from the specification or declared; render_segmented relies on it
+        bool m_tail_known {false};
         GPUA::engine::v2::Processor* m_processor {nullptr};
     };
 
@@ -68,6 +161,42 @@ private:
 
     ProcessExecutorConfig m_executor_config;
     ProcessExecutor<ExecutionMode::eSync>* m_process_executor {nullptr};
+
+    // nchannels_out x nchannels_in; empty if the chain writes the output channels directly
+    std::vector<float> m_routing_matrix;
+    std::vector<float> m_chain_out;
+    std::vector<float*> m_chain_out_ptrs;
+
+    // channel pointers of the current launch if process() is split into multiple launches
+    std::vector<float const*> m_launch_in;
+    std::vector<float*> m_launch_out;
+
+    // channel pointers of process() calls with a channel activity mask
+    ChannelMask m_channel_mask;
+    InactiveChannelOutput m_inactive_output {InactiveChannelOutput::eZero};
+    InactiveChannelState m_inactive_state {InactiveChannelState::eFrozen};
+    // a block without active channels was skipped under InactiveChannelState::eReset
+    bool m_reset_pending {false};
+
+    // silence skipping; the tail is the sum of the processors' tails and is determined when arming
+    bool m_skip_silence {false};
+    float m_silence_threshold {0.f};
+    uint64_t m_tail_samples {0u};
+    // number of consecutive silent input samples that were processed or skipped
+    uint64_t m_silent_samples {0u};
+
+    std::atomic<uint64_t> m_launches {0u};
+    std::atomic<uint64_t> m_skipped_launches {0u};
+
+    // runs the launches if process() calls have a deadline
+    std::unique_ptr<DeadlineExecutor> m_deadline_executor;
+    std::atomic<uint64_t> m_deadline_misses {0u};
+
+    // arm() fails if the memory footprint exceeds the budget; 0 if there is none
+    uint64_t m_memory_budget {0u};
+
+    // records the input of every process() call while a capture is active
+    std::unique_ptr<BlockRecorder> m_recorder;
 };
 
 #endif // GPUA_GPU_PROCESSOR_LAUNCHER_PROCESSOR_H
@@ -0,0 +1,161 @@
+#include "LauncherSnapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+constexpr size_t HeaderSize {4u * sizeof(uint32_t)};
+
+uint32_t fnv1a(std::span<std::byte const> bytes) {
+    uint32_t hash {0x811C9DC5u};
+    for (std::byte b : bytes) {
+        hash ^= static_cast<uint32_t>(b);
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+uint32_t read_magic(std::span<std::byte const> spec) {
+    uint32_t magic;
+    std::memcpy(&magic, spec.data(), sizeof(magic));
+    return magic;
+}
+
+/**
+ * Appends trivially copyable values to a byte buffer
+ */
+struct SnapshotWriter {
+    std::vector<std::byte>& m_out;
+
+    template <typename T>
+    void put(T const& value) {
+        std::byte const* bytes = reinterpret_cast<std::byte const*>(&value);
+        m_out.insert(m_out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void put_bytes(std::span<std::byte const> bytes) {
+        m_out.insert(m_out.end(), bytes.begin(), bytes.end());
+        // keep the following fields aligned
+        m_out.resize((m_out.size() + 3u) & ~size_t {3u}, std::byte {0});
+    }
+};
+
+/**
+ * Reads trivially copyable values from a byte buffer with bounds checking
+ */
+struct SnapshotReader {
+    std::span<std::byte const> m_in;
+    size_t m_offset {0u};
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, get_bytes(sizeof(T), false).data(), sizeof(T));
+        return value;
+    }
+
+    std::span<std::byte const> get_bytes(size_t size, bool aligned = true) {
+        size_t const padded_size = aligned ? ((size + 3u) & ~size_t {3u}) : size;
+        if (padded_size > m_in.size() - m_offset) {
+            throw std::runtime_error("Snapshot is truncated");
+        }
+        std::span<std::byte const> bytes = m_in.subspan(m_offset, size);
+        m_offset += padded_size;
+        return bytes;
+    }
+};
+} // namespace
+
+std::vector<std::byte> LauncherSnapshot::serialize() const {
+    std::vector<std::byte> out(HeaderSize);
+    SnapshotWriter writer {out};
+
+    writer.put(m_executor_config.nchannels_in);
+    writer.put(m_executor_config.nchannels_out);
+    writer.put(m_executor_config.max_samples_per_channel);
+    writer.put(static_cast<double>(m_executor_config.retain_threshold));
+    writer.put(static_cast<double>(m_executor_config.launch_threshold));
+    writer.put(static_cast<uint32_t>(m_routing_matrix.size()));
+    for (float gain : m_routing_matrix) {
+        writer.put(gain);
+    }
+    writer.put(static_cast<uint32_t>(m_processors.size()));
+
+    for (auto const& entry : m_processors) {
+        writer.put(static_cast<uint32_t>(entry.m_module_id.size()));
+        writer.put(static_cast<uint32_t>(entry.m_spec.size()));
+        writer.put(entry.m_tail_samples);
+        // wchar_t differs in size between platforms; store each character as uint32
+        for (wchar_t c : entry.m_module_id) {
+            writer.put(static_cast<uint32_t>(c));
+        }
+        writer.put_bytes(entry.m_spec);
+    }
+
+    // fill in the header now that the payload is known
+    std::span<std::byte const> payload {out.data() + HeaderSize, out.size() - HeaderSize};
+    uint32_t const header[4] {Magic, Version, static_cast<uint32_t>(payload.size()), fnv1a(payload)};
+    std::memcpy(out.data(), header, HeaderSize);
+    return out;
+}
+
+void LauncherSnapshot::write(char const* path) const {
+    std::vector<std::byte> const bytes = serialize();
+
+    std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not open " + std::string(path) + " for writing");
+    }
+    out.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        throw std::runtime_error("Could not write snapshot to " + std::string(path));
+    }
+}
+
+LauncherSnapshot LauncherSnapshot::parse(std::span<std::byte const> bytes) {
+    SnapshotReader reader {bytes};
+
+    if (reader.get<uint32_t>() != Magic) {
+        throw std::runtime_error("Not a launcher snapshot");
+    }
+    if (reader.get<uint32_t>() != Version) {
+        throw std::runtime_error("Unsupported launcher snapshot version");
+    }
+    uint32_t const payload_size = reader.get<uint32_t>();
+    uint32_t const checksum = reader.get<uint32_t>();
+    if (payload_size != bytes.size() - HeaderSize || fnv1a(bytes.subspan(HeaderSize)) != checksum) {
+        throw std::runtime_error("Launcher snapshot is corrupted");
+    }
+
+    LauncherSnapshot snapshot;
+    snapshot.m_executor_config.nchannels_in = reader.get<uint32_t>();
+    snapshot.m_executor_config.nchannels_out = reader.get<uint32_t>();
+    snapshot.m_executor_config.max_samples_per_channel = reader.get<uint32_t>();
+    snapshot.m_executor_config.retain_threshold = static_cast<decltype(snapshot.m_executor_config.retain_threshold)>(reader.get<double>());
+    snapshot.m_executor_config.launch_threshold = static_cast<decltype(snapshot.m_executor_config.launch_threshold)>(reader.get<double>());
+
+    snapshot.m_routing_matrix.resize(reader.get<uint32_t>());
+    for (float& gain : snapshot.m_routing_matrix) {
+        gain = reader.get<float>();
+    }
+
+    uint32_t const nprocessors = reader.get<uint32_t>();
+    snapshot.m_processors.resize(nprocessors);
+    for (auto& entry : snapshot.m_processors) {
+        uint32_t const id_length = reader.get<uint32_t>();
+        uint32_t const spec_size = reader.get<uint32_t>();
+        entry.m_tail_samples = reader.get<uint32_t>();
+
+        entry.m_module_id.resize(id_length);
+        for (wchar_t& c : entry.m_module_id) {
+            c = static_cast<wchar_t>(reader.get<uint32_t>());
+        }
+        entry.m_spec = reader.get_bytes(spec_size);
+        // every Specification starts with its magic; the checksum doesn't catch a spec that was wrong when it was saved
+        if (entry.m_spec.size() < sizeof(uint32_t) || read_magic(entry.m_spec) == 0u) {
+            throw std::runtime_error("Launcher snapshot contains an invalid processor specification");
+        }
+    }
+    return snapshot;
+}
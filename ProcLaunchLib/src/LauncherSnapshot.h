@@ -0,0 +1,62 @@
+#ifndef GPUA_LAUNCHER_SNAPSHOT_H
+#define GPUA_LAUNCHER_SNAPSHOT_H
+
+#include <gpu_audio_client/ProcessExecutorSync.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Versioned binary snapshot of a launcher configuration and its ordered list of processors.
+ *
+ * Layout (host byte order, all fields 4-byte aligned):
+ *   header:    magic, version, payload size, payload checksum (FNV-1a)
+ *   payload:   nchannels_in, nchannels_out, max_samples_per_channel, retain_threshold (f64),
+ *              launch_threshold (f64), routing matrix size and entries (f32), processor count,
+ *              followed by one record per processor
+ *   processor: id length, spec size, tail samples, id (one uint32 per character), spec (padded to 4 bytes);
+ *              the spec starts with the non-zero magic of the processor's Specification
+ */
+struct LauncherSnapshot {
+    static constexpr uint32_t Magic = 0x4E53504Cu; // "LPSN"
+    static constexpr uint32_t Version = 1u;
+
+    /**
+     * A processor of the snapshot. The specification references memory owned by whoever provided it
+     * (e.g., the launcher when saving or the mapped file when restoring).
+     */
+    struct ProcessorEntry {
+        std::wstring m_module_id;
+        std::span<std::byte const> m_spec;
+        uint32_t m_tail_samples {0u};
+    };
+
+    ProcessExecutorConfig m_executor_config {};
+    // maps the chain's output channels to the launcher's output channels; empty if there is none
+    std::vector<float> m_routing_matrix;
+    std::vector<ProcessorEntry> m_processors;
+
+    /**
+     * @brief Serialize the snapshot
+     * @return the serialized snapshot
+     */
+    std::vector<std::byte> serialize() const;
+
+    /**
+     * @brief Serialize the snapshot and write it to a file
+     * @param path [in] path of the file to write
+     */
+    void write(char const* path) const;
+
+    /**
+     * @brief Parse and validate a serialized snapshot. The specifications of the returned snapshot reference `bytes`.
+     * @param bytes [in] serialized snapshot
+     * @return the parsed snapshot
+     */
+    static LauncherSnapshot parse(std::span<std::byte const> bytes);
+};
+
+#endif // GPUA_LAUNCHER_SNAPSHOT_H
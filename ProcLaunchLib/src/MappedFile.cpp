@@ -0,0 +1,95 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(char const* path) {
+    m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        throw std::runtime_error("Could not open " + std::string(path) + " for reading");
+    }
+
+    LARGE_INTEGER size {};
+    if (!GetFileSizeEx(m_file, &size)) {
+        CloseHandle(m_file);
+        throw std::runtime_error("Could not determine the size of " + std::string(path));
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    // empty files can't be mapped; they are represented by an empty span
+    if (m_size == 0u) {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) {
+        CloseHandle(m_file);
+        throw std::runtime_error("Could not map " + std::string(path));
+    }
+    m_data = static_cast<std::byte const*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        throw std::runtime_error("Could not map " + std::string(path));
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(char const* path) {
+    int const fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open " + std::string(path) + " for reading");
+    }
+
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not determine the size of " + std::string(path));
+    }
+    m_size = static_cast<size_t>(file_stat.st_size);
+    // empty files can't be mapped; they are represented by an empty span
+    if (m_size == 0u) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the file descriptor
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + std::string(path));
+    }
+    m_data = static_cast<std::byte const*>(data);
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+}
+
+#endif
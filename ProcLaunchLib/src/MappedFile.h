@@ -0,0 +1,43 @@
+#ifndef GPUA_MAPPED_FILE_H
+#define GPUA_MAPPED_FILE_H
+
+#include <cstddef>
+#include <span>
+
+/**
+ * Read-only memory mapping of a whole file; the mapping is released on destruction
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Constructor; maps the file into memory
+     * @param path [in] path of the file to map
+     */
+    explicit MappedFile(char const* path);
+
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    /**
+     * @brief Get the content of the mapped file
+     */
+    std::span<std::byte const> bytes() const {
+        return {m_data, m_size};
+    }
+
+private:
+    std::byte const* m_data {nullptr};
+    size_t m_size {0u};
+
+#ifdef _WIN32
+    void* m_file {nullptr};
+    void* m_mapping {nullptr};
+#endif
+};
+
+#endif // GPUA_MAPPED_FILE_H
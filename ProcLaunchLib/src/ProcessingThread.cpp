@@ -0,0 +1,141 @@
+#include "ProcessingThread.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+std::mutex g_mutex;
+ThreadConfig g_config;
+std::map<uint64_t, ThreadReport> g_reports;
+uint64_t g_next_id {0u};
+
+bool apply_affinity(std::vector<uint32_t> const& cpus) {
+#if defined(_WIN32)
+    DWORD_PTR mask {0u};
+    for (uint32_t cpu : cpus) {
+        if (cpu < 8u * sizeof(DWORD_PTR)) {
+            mask |= DWORD_PTR {1u} << cpu;
+        }
+    }
+    return mask != 0u && SetThreadAffinityMask(GetCurrentThread(), mask) != 0u;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) != 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    // e.g., macOS doesn't support binding threads to CPUs
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool apply_scheduling(ThreadScheduling scheduling, int priority) {
+#ifdef _WIN32
+    (void)scheduling;
+    (void)priority;
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#else
+    int const policy = scheduling == ThreadScheduling::eFifo ? SCHED_FIFO : SCHED_RR;
+    sched_param param {};
+    param.sched_priority = std::clamp(priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    // fails without the permission to use real-time scheduling (e.g., CAP_SYS_NICE or an rtprio limit on Linux)
+    return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+#endif
+}
+
+bool apply_denormals() {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+    // FTZ (bit 15) and DAZ (bit 6) of the MXCSR
+    _mm_setcsr(_mm_getcsr() | 0x8040u);
+    return true;
+#elif defined(__aarch64__)
+    // FZ (bit 24) of the FPCR
+    uint64_t fpcr;
+    asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+    asm volatile("msr fpcr, %0" : : "r"(fpcr | (uint64_t {1u} << 24)));
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool apply_name(std::string const& name) {
+#if defined(__linux__)
+    // names are limited to 15 characters
+    return pthread_setname_np(pthread_self(), name.substr(0u, 15u).c_str()) == 0;
+#elif defined(__APPLE__)
+    return pthread_setname_np(name.c_str()) == 0;
+#else
+    (void)name;
+    return false;
+#endif
+}
+} // namespace
+
+void set_processing_thread_config(ThreadConfig const& config) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_config = config;
+}
+
+std::vector<ThreadReport> get_processing_thread_reports() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    std::vector<ThreadReport> reports;
+    reports.reserve(g_reports.size());
+    for (auto const& [id, report] : g_reports) {
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+ThreadReport apply_thread_config(ThreadConfig const& config, std::string const& name) {
+    ThreadReport report {.name = name};
+    if (!config.cpus.empty()) {
+        report.affinity_applied = apply_affinity(config.cpus);
+    }
+    if (config.scheduling != ThreadScheduling::eDefault) {
+        report.scheduling_applied = apply_scheduling(config.scheduling, config.priority);
+    }
+    if (config.flush_denormals) {
+        report.denormals_applied = apply_denormals();
+    }
+    if (!name.empty()) {
+        report.name_applied = apply_name(name);
+    }
+    return report;
+}
+
+ProcessingThreadScope::ProcessingThreadScope(std::string const& name) {
+    ThreadConfig config;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        config = g_config;
+        m_id = g_next_id++;
+    }
+
+    ThreadReport report = apply_thread_config(config, name);
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_reports.emplace(m_id, std::move(report));
+}
+
+ProcessingThreadScope::~ProcessingThreadScope() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_reports.erase(m_id);
+}
@@ -0,0 +1,65 @@
+#ifndef GPUA_PROCESSING_THREAD_H
+#define GPUA_PROCESSING_THREAD_H
+
+#include <ThreadConfig.h>
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Set the configuration applied to processing threads the library starts from now on
+ */
+void set_processing_thread_config(ThreadConfig const& config);
+
+/**
+ * @brief Get the reports of all processing threads the library started that are still running
+ */
+std::vector<ThreadReport> get_processing_thread_reports();
+
+/**
+ * @brief Apply a configuration and a name to the calling thread; settings that fail are skipped
+ * @param config [in] settings to apply
+ * @param name [in] name of the thread; truncated to what the platform supports
+ * @return the settings that were applied
+ */
+ThreadReport apply_thread_config(ThreadConfig const& config, std::string const& name);
+
+/**
+ * Applies the processing thread configuration to the calling thread and keeps its report registered while it exists
+ */
+class ProcessingThreadScope {
+public:
+    /**
+     * @brief Constructor; applies the configuration to the calling thread and registers its report
+     * @param name [in] name of the thread
+     */
+    explicit ProcessingThreadScope(std::string const& name);
+
+    /**
+     * @brief Destructor; unregisters the report
+     */
+    ~ProcessingThreadScope();
+
+    ProcessingThreadScope(ProcessingThreadScope const&) = delete;
+    ProcessingThreadScope& operator=(ProcessingThreadScope const&) = delete;
+
+private:
+    uint64_t m_id {0u};
+};
+
+/**
+ * @brief Start a thread that runs `function` with the processing thread configuration applied
+ * @param name [in] name of the thread
+ * @param function [in] function the thread runs
+ */
+template <typename Function>
+std::thread start_processing_thread(std::string name, Function&& function) {
+    return std::thread([name = std::move(name), function = std::forward<Function>(function)]() mutable {
+        ProcessingThreadScope scope(name);
+        function();
+    });
+}
+
+#endif // GPUA_PROCESSING_THREAD_H
@@ -0,0 +1,240 @@
+#include "ProcessorLauncherFarm.h"
+
+#include "ProcessingThread.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+ProcessorLauncherFarm::ProcessorLauncherFarm(uint32_t nworkers) {
+    if (nworkers == 0u) {
+        nworkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // create all workers before starting any thread; workers steal from each other right away
+    m_workers.reserve(nworkers);
+    for (uint32_t w_id {0u}; w_id < nworkers; ++w_id) {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (uint32_t w_id {0u}; w_id < nworkers; ++w_id) {
+        m_workers[w_id]->m_thread = start_processing_thread("gpua-farm-" + std::to_string(w_id), [this, w_id] { worker_loop(w_id); });
+    }
+}
+
+ProcessorLauncherFarm::~ProcessorLauncherFarm() {
+    // finish all pending blocks; errors can't be reported anymore at this point
+    try {
+        wait_all();
+    }
+    catch (...) {
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+        m_stop = true;
+    }
+    m_idle_cv.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker->m_thread.join();
+    }
+}
+
+uint32_t ProcessorLauncherFarm::add_stream(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out) {
+    if (!launcher) {
+        throw std::runtime_error("Error ProcessorLauncherFarm::add_stream called without launcher");
+    }
+
+    auto stream = std::make_shared<Stream>();
+    stream->m_launcher = std::move(launcher);
+    stream->m_nchannels_in = nchannels_in;
+    stream->m_nchannels_out = nchannels_out;
+
+    std::unique_lock<std::shared_mutex> lock(m_streams_mutex);
+    uint32_t const stream_id = m_next_stream_id++;
+    // distribute the streams over the workers; stealing evens out the load from there on
+    stream->m_home_worker = stream_id % static_cast<uint32_t>(m_workers.size());
+    m_streams.emplace(stream_id, std::move(stream));
+    return stream_id;
+}
+
+void ProcessorLauncherFarm::remove_stream(uint32_t stream_id) {
+    // unlink the stream first; no new blocks can be submitted to it from here on
+    std::shared_ptr<Stream> stream;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_streams_mutex);
+        auto it = m_streams.find(stream_id);
+        if (it == m_streams.end()) {
+            throw std::runtime_error("Error ProcessorLauncherFarm: unknown stream id");
+        }
+        stream = std::move(it->second);
+        m_streams.erase(it);
+    }
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(stream->m_mutex);
+        stream->m_done_cv.wait(lock, [&stream] { return !stream->m_scheduled; });
+        error = stream->m_error;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ProcessorLauncherFarm::submit(uint32_t stream_id, float const* const* input, float* const* output, int nsamples) {
+    std::shared_ptr<Stream> stream = find_stream(stream_id);
+
+    bool schedule_stream {false};
+    {
+        std::lock_guard<std::mutex> lock(stream->m_mutex);
+        // copy the channel pointers; the caller's pointer arrays don't have to outlive this call
+        Block& block = stream->m_pending.emplace_back();
+        block.m_input.assign(input, input + stream->m_nchannels_in);
+        block.m_output.assign(output, output + stream->m_nchannels_out);
+        block.m_nsamples = nsamples;
+
+        // a stream that is already scheduled picks up the new block once the previous ones are done
+        if (!stream->m_scheduled) {
+            stream->m_scheduled = true;
+            schedule_stream = true;
+        }
+    }
+
+    if (schedule_stream) {
+        schedule(std::move(stream));
+    }
+}
+
+void ProcessorLauncherFarm::wait(uint32_t stream_id) {
+    std::shared_ptr<Stream> stream = find_stream(stream_id);
+
+    std::unique_lock<std::mutex> lock(stream->m_mutex);
+    stream->m_done_cv.wait(lock, [&stream] { return !stream->m_scheduled; });
+    if (stream->m_error) {
+        std::exception_ptr error = stream->m_error;
+        stream->m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ProcessorLauncherFarm::wait_all() {
+    std::vector<uint32_t> stream_ids;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_streams_mutex);
+        stream_ids.reserve(m_streams.size());
+        for (auto const& [stream_id, stream] : m_streams) {
+            stream_ids.push_back(stream_id);
+        }
+    }
+
+    for (uint32_t stream_id : stream_ids) {
+        wait(stream_id);
+    }
+}
+
+uint32_t ProcessorLauncherFarm::get_worker_count() const {
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+void ProcessorLauncherFarm::worker_loop(uint32_t worker_idx) {
+    while (true) {
+        if (std::shared_ptr<Stream> stream = pop_ready(worker_idx)) {
+            process_block(std::move(stream), worker_idx);
+            continue;
+        }
+
+        // nothing to do for this worker and nothing to steal; sleep until a stream becomes ready
+        std::unique_lock<std::mutex> lock(m_idle_mutex);
+        m_idle_cv.wait(lock, [this] { return m_stop || m_ready_count.load() != 0u; });
+        if (m_stop && m_ready_count.load() == 0u) {
+            return;
+        }
+    }
+}
+
+void ProcessorLauncherFarm::schedule(std::shared_ptr<Stream> stream) {
+    Worker& worker = *m_workers[stream->m_home_worker];
+    {
+        std::lock_guard<std::mutex> lock(worker.m_mutex);
+        worker.m_ready.push_back(std::move(stream));
+        // count while holding the queue lock s.t. the counter never is lower than the number of queued streams
+        m_ready_count.fetch_add(1u);
+    }
+
+    // notify under the idle lock to not miss a worker that is about to go to sleep
+    std::lock_guard<std::mutex> lock(m_idle_mutex);
+    m_idle_cv.notify_one();
+}
+
+std::shared_ptr<ProcessorLauncherFarm::Stream> ProcessorLauncherFarm::pop_ready(uint32_t worker_idx) {
+    uint32_t const nworkers = static_cast<uint32_t>(m_workers.size());
+
+    // take the oldest ready stream of the own queue first
+    {
+        Worker& worker = *m_workers[worker_idx];
+        std::lock_guard<std::mutex> lock(worker.m_mutex);
+        if (!worker.m_ready.empty()) {
+            std::shared_ptr<Stream> stream = std::move(worker.m_ready.front());
+            worker.m_ready.pop_front();
+            m_ready_count.fetch_sub(1u);
+            return stream;
+        }
+    }
+
+    // steal the most recently queued stream of another worker
+    for (uint32_t offset {1u}; offset < nworkers; ++offset) {
+        Worker& victim = *m_workers[(worker_idx + offset) % nworkers];
+        std::lock_guard<std::mutex> lock(victim.m_mutex);
+        if (!victim.m_ready.empty()) {
+            std::shared_ptr<Stream> stream = std::move(victim.m_ready.back());
+            victim.m_ready.pop_back();
+            m_ready_count.fetch_sub(1u);
+            return stream;
+        }
+    }
+    return nullptr;
+}
+
+void ProcessorLauncherFarm::process_block(std::shared_ptr<Stream> stream, uint32_t worker_idx) {
+    Block block;
+    {
+        std::lock_guard<std::mutex> lock(stream->m_mutex);
+        block = std::move(stream->m_pending.front());
+        stream->m_pending.pop_front();
+    }
+
+    // only this worker holds the stream, so the launcher is used by one thread at a time
+    std::exception_ptr error;
+    try {
+        stream->m_launcher->process(block.m_input.data(), block.m_output.data(), block.m_nsamples);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stream->m_mutex);
+        if (error && !stream->m_error) {
+            stream->m_error = error;
+        }
+        stream->m_home_worker = worker_idx;
+        if (stream->m_pending.empty()) {
+            stream->m_scheduled = false;
+            stream->m_done_cv.notify_all();
+            return;
+        }
+    }
+
+    // more blocks are pending; re-queue the stream behind the other ready streams of this worker
+    schedule(std::move(stream));
+}
+
+std::shared_ptr<ProcessorLauncherFarm::Stream> ProcessorLauncherFarm::find_stream(uint32_t stream_id) {
+    std::shared_lock<std::shared_mutex> lock(m_streams_mutex);
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end()) {
+        throw std::runtime_error("Error ProcessorLauncherFarm: unknown stream id");
+    }
+    return it->second;
+}
@@ -0,0 +1,103 @@
+#ifndef GPUA_PROCESSOR_LAUNCHER_FARM_H
+#define GPUA_PROCESSOR_LAUNCHER_FARM_H
+
+#include <ProcessorLauncherFarmInterface.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing farm of worker threads that process the blocks of many streams; implements the ProcessorLauncherFarmInterface
+ */
+class ProcessorLauncherFarm : public ProcessorLauncherFarmInterface {
+public:
+    /**
+     * @brief Constructor; starts the worker threads
+     * @param nworkers [in] number of worker threads; 0 creates one worker per hardware thread
+     */
+    explicit ProcessorLauncherFarm(uint32_t nworkers);
+
+    /**
+     * @brief Destructor; waits for all pending blocks and joins the worker threads
+     */
+    virtual ~ProcessorLauncherFarm();
+
+    ////////////////////////////////
+    // ProcessorLauncherFarmInterface methods
+    virtual uint32_t add_stream(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out) override;
+    virtual void remove_stream(uint32_t stream_id) override;
+    virtual void submit(uint32_t stream_id, float const* const* input, float* const* output, int nsamples) override;
+    virtual void wait(uint32_t stream_id) override;
+    virtual void wait_all() override;
+    virtual uint32_t get_worker_count() const override;
+    // ProcessorLauncherFarmInterface methods
+    ////////////////////////////////
+
+private:
+    /**
+     * A block that was submitted to a stream but not yet processed
+     */
+    struct Block {
+        std::vector<float const*> m_input;
+        std::vector<float*> m_output;
+        int m_nsamples {0};
+    };
+
+    /**
+     * A stream and its pending blocks. At most one worker processes a stream at a time, which
+     * preserves the block order and keeps the launcher single-threaded.
+     */
+    struct Stream {
+        std::unique_ptr<ProcessorLauncherInterface> m_launcher;
+        uint32_t m_nchannels_in {0u};
+        uint32_t m_nchannels_out {0u};
+
+        std::mutex m_mutex;
+        std::condition_variable m_done_cv;
+        std::deque<Block> m_pending;
+        // true while the stream sits in a worker's ready queue or is being processed by a worker
+        bool m_scheduled {false};
+        // index of the worker that processed the stream last; the stream is re-queued there
+        uint32_t m_home_worker {0u};
+        std::exception_ptr m_error;
+    };
+
+    /**
+     * A worker thread and its queue of streams that are ready for processing
+     */
+    struct Worker {
+        std::mutex m_mutex;
+        std::deque<std::shared_ptr<Stream>> m_ready;
+        std::thread m_thread;
+    };
+
+    void worker_loop(uint32_t worker_idx);
+    void schedule(std::shared_ptr<Stream> stream);
+    std::shared_ptr<Stream> pop_ready(uint32_t worker_idx);
+    void process_block(std::shared_ptr<Stream> stream, uint32_t worker_idx);
+    std::shared_ptr<Stream> find_stream(uint32_t stream_id);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::shared_mutex m_streams_mutex;
+    // shared with the ready queues and with calls in flight s.t. a removed stream stays alive until they are done
+    std::map<uint32_t, std::shared_ptr<Stream>> m_streams;
+    uint32_t m_next_stream_id {0u};
+
+    // idle workers sleep until a stream becomes ready or the farm shuts down
+    std::mutex m_idle_mutex;
+    std::condition_variable m_idle_cv;
+    std::atomic<uint64_t> m_ready_count {0u};
+    bool m_stop {false};
+};
+
+#endif // GPUA_PROCESSOR_LAUNCHER_FARM_H
@@ -0,0 +1,68 @@
+#include "ProcessorTails.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+// leading fields of the processors' specifications; see the specification headers of the gain, fir and iir launchers
+constexpr uint32_t GainMagic {0xDE2F52ACu};
+
+constexpr uint32_t FirMagic {0xAC90FB31u};
+struct FirSpecification {
+    uint32_t magic;
+    uint32_t filter_length;
+};
+
+constexpr uint32_t IirMagic {0xCF104BDu};
+struct IirSpecification {
+    uint32_t magic;
+    float sample_rate;
+    float band_pass_freq;
+    float band_pass_q;
+};
+
+template <typename T>
+std::optional<T> read_spec(std::span<std::byte const> spec, uint32_t magic) {
+    T value;
+    if (spec.size() < sizeof(T)) {
+        return std::nullopt;
+    }
+    std::memcpy(&value, spec.data(), sizeof(T));
+    if (value.magic != magic) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+struct Magic {
+    uint32_t magic;
+};
+} // namespace
+
+std::optional<uint32_t> derive_tail_samples(std::wstring const& p_id, std::span<std::byte const> spec) {
+    if (p_id == L"gain") {
+        // memoryless
+        return read_spec<Magic>(spec, GainMagic) ? std::optional<uint32_t> {0u} : std::nullopt;
+    }
+    if (p_id == L"fir") {
+        // the output depends on the last filter_length input samples
+        auto const fir = read_spec<FirSpecification>(spec, FirMagic);
+        return fir ? std::optional<uint32_t> {fir->filter_length} : std::nullopt;
+    }
+    if (p_id == L"iir") {
+        // the poles of the band-pass biquad have a radius of about exp(-pi * f / (q * sr)); count the samples until the
+        // ring-out decayed by 120dB
+        auto const iir = read_spec<IirSpecification>(spec, IirMagic);
+        if (!iir) {
+            return std::nullopt;
+        }
+        if (!(iir->band_pass_freq > 0.f) || !(iir->sample_rate > 0.f) || !(iir->band_pass_q > 0.f)) {
+            return 0u;
+        }
+        constexpr double decay {13.815510557964274}; // ln(10^6)
+        double const tail = std::ceil(decay * iir->band_pass_q * iir->sample_rate / (3.14159265358979323846 * iir->band_pass_freq));
+        return static_cast<uint32_t>(std::min(tail, 4294967295.0));
+    }
+    return std::nullopt;
+}
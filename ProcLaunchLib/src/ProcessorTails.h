@@ -0,0 +1,19 @@
+#ifndef GPUA_PROCESSOR_TAILS_H
+#define GPUA_PROCESSOR_TAILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+/**
+ * @brief Derive the tail of a processor the library knows (gain, fir, iir) from its specification
+ * @param p_id [in] unique identifier of the processor module
+ * @param spec [in] the processor's specification
+ * @return number of samples the processor's output keeps ringing after its input turned silent; std::nullopt if the
+ * processor is unknown or the specification doesn't match the known layout
+ */
+std::optional<uint32_t> derive_tail_samples(std::wstring const& p_id, std::span<std::byte const> spec);
+
+#endif // GPUA_PROCESSOR_TAILS_H
@@ -0,0 +1,316 @@
+#include "SharedMemoryLauncher.h"
+
+#include "DeadlineExecutor.h"
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace SharedMemoryProtocol;
+
+namespace {
+// how often a waiting process() checks whether the server is still alive
+constexpr int ServerCheckIntervalMs {100};
+
+template <typename T>
+std::span<std::byte const> as_payload(T const& value) {
+    return {reinterpret_cast<std::byte const*>(&value), sizeof(T)};
+}
+
+template <typename T>
+T from_payload(std::vector<std::byte> const& payload) {
+    if (payload.size() < sizeof(T)) {
+        throw std::runtime_error("Malformed processing server response");
+    }
+    T value;
+    std::memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+} // namespace
+
+SharedMemoryLauncher::SharedMemoryLauncher(char const* socket_path, ProcessExecutorConfig const& executor_config, std::vector<float> routing_matrix) :
+    m_nchannels_in {executor_config.nchannels_in},
+    m_nchannels_out {routing_matrix.empty() ? executor_config.nchannels_out : static_cast<uint32_t>(routing_matrix.size() / std::max(executor_config.nchannels_in, 1u))},
+    m_executor_config {executor_config},
+    m_routing_matrix {std::move(routing_matrix)},
+    m_channel_mask(m_nchannels_in, m_nchannels_out, m_routing_matrix.empty()) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(socket_path) >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long");
+    }
+    std::strcpy(address.sun_path, socket_path);
+
+    m_socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_socket < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+    if (::connect(m_socket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        ::close(m_socket);
+        throw std::runtime_error("Failed to connect to the processing server");
+    }
+}
+
+SharedMemoryLauncher::~SharedMemoryLauncher() {
+    try {
+        disarm();
+    }
+    catch (...) {
+    }
+    ::close(m_socket);
+}
+
+void SharedMemoryLauncher::arm() {
+    if (m_armed) {
+        return;
+    }
+
+    std::vector<std::byte> payload(sizeof(ArmSettings));
+    std::memcpy(payload.data(), &m_settings, sizeof(ArmSettings));
+    std::vector<std::byte> const snapshot = make_snapshot().serialize();
+    payload.insert(payload.end(), snapshot.begin(), snapshot.end());
+
+    int memory_fd {-1};
+    request(Op::eArm, payload, &memory_fd);
+    if (memory_fd < 0) {
+        throw std::runtime_error("Processing server did not share the stream memory");
+    }
+
+    uint32_t const capacity = m_executor_config.max_samples_per_channel;
+    m_memory_size = shared_memory_size(m_nchannels_in, m_nchannels_out, capacity);
+    m_memory = ::mmap(nullptr, m_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    ::close(memory_fd);
+    if (m_memory == MAP_FAILED) {
+        m_memory = nullptr;
+        request(Op::eDisarm);
+        throw std::runtime_error("Failed to map shared memory");
+    }
+    m_block = static_cast<BlockHeader*>(m_memory);
+    m_input = input_channels(m_block, m_nchannels_in, capacity);
+    m_output = output_channels(m_block, m_nchannels_in, m_nchannels_out, capacity);
+    m_armed = true;
+}
+
+void SharedMemoryLauncher::disarm() {
+    if (!m_armed) {
+        return;
+    }
+    m_armed = false;
+
+    ::munmap(m_memory, m_memory_size);
+    m_memory = nullptr;
+    m_block = nullptr;
+    m_acquired_samples = 0u;
+    request(Op::eDisarm);
+}
+
+void SharedMemoryLauncher::process(float const* const* in_buffer, float* const* out_buffer, int nsamples) {
+    if (!m_armed) {
+        arm();
+    }
+
+    // blocks larger than the shared memory are passed on in parts; in place, each part is read before it is written
+    uint32_t const total_samples = static_cast<uint32_t>(std::max(nsamples, 0));
+    for (uint32_t offset {0u}; offset < total_samples;) {
+        uint32_t const this_block_samples = std::min(m_executor_config.max_samples_per_channel, total_samples - offset);
+        for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+            std::memcpy(m_input[ch], in_buffer[ch] + offset, this_block_samples * sizeof(float));
+        }
+        run_block(this_block_samples);
+        for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+            std::memcpy(out_buffer[ch] + offset, m_output[ch], this_block_samples * sizeof(float));
+        }
+        offset += this_block_samples;
+    }
+}
+
+void SharedMemoryLauncher::process(float const* const* in_buffer, float* const* out_buffer, int nsamples, uint8_t const* active_channels) {
+    if (!active_channels) {
+        process(in_buffer, out_buffer, nsamples);
+        return;
+    }
+
+    // a block without active channels isn't sent to the server at all
+    uint32_t const total_samples = static_cast<uint32_t>(std::max(nsamples, 0));
+    bool const any_active = m_channel_mask.prepare(in_buffer, out_buffer, total_samples, active_channels);
+    if (any_active) {
+        process(m_channel_mask.input(), m_channel_mask.output(), nsamples);
+    }
+    else {
+        m_reset_pending |= m_inactive_state == InactiveChannelState::eReset;
+    }
+    m_channel_mask.finish(out_buffer, total_samples, active_channels, !any_active, m_inactive_output);
+}
+
+void SharedMemoryLauncher::set_inactive_channel_output(InactiveChannelOutput policy) {
+    m_inactive_output = policy;
+}
+
+void SharedMemoryLauncher::set_inactive_channel_state(InactiveChannelState policy) {
+    m_inactive_state = policy;
+}
+
+void SharedMemoryLauncher::run_block(uint32_t nsamples) {
+    // the first block after blocks without active channels under InactiveChannelState::eReset
+    if (m_reset_pending) {
+        request(Op::eResetProcessors);
+        m_reset_pending = false;
+    }
+
+    m_block->nsamples = nsamples;
+    uint32_t const block_id = m_block->request.load(std::memory_order_relaxed) + 1u;
+    m_block->request.store(block_id, std::memory_order_release);
+    futex_wake(m_block->request);
+
+    while (true) {
+        uint32_t const response = m_block->response.load(std::memory_order_acquire);
+        if (response == block_id) {
+            break;
+        }
+        futex_wait(m_block->response, response, ServerCheckIntervalMs);
+
+        // don't wait forever for a server that went away
+        pollfd server {.fd = m_socket, .events = POLLRDHUP};
+        if (::poll(&server, 1u, 0) > 0 && (server.revents & (POLLRDHUP | POLLHUP | POLLERR)) != 0) {
+            throw std::runtime_error("Processing server disconnected");
+        }
+    }
+
+    if (m_block->failed != 0u) {
+        throw std::runtime_error("Processing server failed to process the block");
+    }
+}
+
+double SharedMemoryLauncher::warm_up(uint32_t nblocks) {
+    arm();
+    return from_payload<double>(request(Op::eWarmUp, as_payload(nblocks)));
+}
+
+void SharedMemoryLauncher::render_segmented(float const* const* input, float* const* output, uint32_t nsamples, uint32_t) {
+    // the server renders one block of a client at a time; segments would only queue up behind each other
+    process(input, output, static_cast<int>(nsamples));
+}
+
+float* const* SharedMemoryLauncher::acquire_input(uint32_t nsamples) {
+    arm();
+    // the input is written straight to the shared memory
+    if (nsamples > m_executor_config.max_samples_per_channel) {
+        throw std::runtime_error("Error SharedMemoryLauncher::acquire_input called with more samples than the stream's capacity");
+    }
+    m_acquired_samples = nsamples;
+    return m_input.data();
+}
+
+float const* const* SharedMemoryLauncher::commit(uint32_t nsamples) {
+    if (!m_armed || nsamples > m_acquired_samples) {
+        throw std::runtime_error("Error SharedMemoryLauncher::commit called with more samples than acquired");
+    }
+    run_block(nsamples);
+    m_acquired_samples = 0u;
+    return m_output.data();
+}
+
+void SharedMemoryLauncher::load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size, uint32_t tail_samples) {
+    if (m_armed) {
+        throw std::runtime_error("Error SharedMemoryLauncher::load_processor called while armed");
+    }
+
+    // the server validates the processor when arming
+    ProcDesc& p_desc = m_processors.emplace_back();
+    p_desc.m_module_id = p_id;
+    p_desc.m_processor_spec.assign(static_cast<std::byte const*>(p_data), static_cast<std::byte const*>(p_data) + p_data_size);
+    p_desc.m_tail_samples = tail_samples;
+}
+
+void SharedMemoryLauncher::save_snapshot(char const* snapshot_path) {
+    make_snapshot().write(snapshot_path);
+}
+
+void SharedMemoryLauncher::start_capture(char const* capture_path) {
+    arm();
+    request(Op::eStartCapture, std::span<std::byte const>(reinterpret_cast<std::byte const*>(capture_path), std::strlen(capture_path)));
+}
+
+void SharedMemoryLauncher::stop_capture() {
+    if (m_armed) {
+        request(Op::eStopCapture);
+    }
+}
+
+void SharedMemoryLauncher::set_silence_skipping(bool enable, float threshold) {
+    m_settings.skip_silence = enable ? 1u : 0u;
+    m_settings.silence_threshold = threshold;
+    if (m_armed) {
+        request(Op::eSetSilenceSkipping, as_payload(SilenceSkipping {.enable = m_settings.skip_silence, .threshold = threshold}));
+    }
+}
+
+void SharedMemoryLauncher::set_deadline(DeadlineConfig const& config) {
+    DeadlineExecutor::check_config(config);
+    m_settings.has_deadline = 1u;
+    m_settings.deadline = config;
+    if (m_armed) {
+        request(Op::eSetDeadline, as_payload(config));
+    }
+}
+
+void SharedMemoryLauncher::clear_deadline() {
+    m_settings.has_deadline = 0u;
+    if (m_armed) {
+        request(Op::eClearDeadline);
+    }
+}
+
+LauncherStatistics SharedMemoryLauncher::get_statistics() const {
+    if (!m_armed) {
+        return {};
+    }
+    return from_payload<LauncherStatistics>(request(Op::eGetStatistics));
+}
+
+MemoryFootprint SharedMemoryLauncher::get_memory_footprint() const {
+    if (!m_armed) {
+        return {};
+    }
+    // the channel activity mask is applied on this side
+    MemoryFootprint footprint = from_payload<MemoryFootprint>(request(Op::eGetMemoryFootprint));
+    footprint.scratch += m_channel_mask.memory_footprint();
+    return footprint;
+}
+
+void SharedMemoryLauncher::set_memory_budget(uint64_t budget_bytes) {
+    m_settings.memory_budget = budget_bytes;
+    if (m_armed) {
+        request(Op::eSetMemoryBudget, as_payload(budget_bytes));
+    }
+}
+
+std::vector<std::byte> SharedMemoryLauncher::request(Op op, std::span<std::byte const> payload, int* fd) const {
+    send_message(m_socket, static_cast<uint32_t>(op), payload);
+
+    uint32_t status {0u};
+    std::vector<std::byte> response;
+    if (!receive_message(m_socket, status, response, fd)) {
+        throw std::runtime_error("Processing server disconnected");
+    }
+    if (static_cast<Status>(status) != Status::eOk) {
+        throw std::runtime_error(std::string(reinterpret_cast<char const*>(response.data()), response.size()));
+    }
+    return response;
+}
+
+LauncherSnapshot SharedMemoryLauncher::make_snapshot() const {
+    LauncherSnapshot snapshot {.m_executor_config = m_executor_config, .m_routing_matrix = m_routing_matrix};
+    snapshot.m_processors.reserve(m_processors.size());
+    for (auto const& p_desc : m_processors) {
+        snapshot.m_processors.push_back({.m_module_id = p_desc.m_module_id, .m_spec = p_desc.m_processor_spec, .m_tail_samples = p_desc.m_tail_samples});
+    }
+    return snapshot;
+}
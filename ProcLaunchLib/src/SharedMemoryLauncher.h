@@ -0,0 +1,115 @@
+#ifndef GPUA_SHARED_MEMORY_LAUNCHER_H
+#define GPUA_SHARED_MEMORY_LAUNCHER_H
+
+#include <SharedMemoryLauncherInterface.h>
+
+#include "ChannelMask.h"
+#include "LauncherSnapshot.h"
+#include "SharedMemoryProtocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Client of a processing server (Linux only); implements the SharedMemoryLauncherInterface by forwarding all calls to a
+ * launcher the server creates when this one is armed. Settings made before arming are applied by the server before it arms.
+ */
+class SharedMemoryLauncher : public SharedMemoryLauncherInterface {
+public:
+    /**
+     * @brief Constructor; connects to the server
+     * @param socket_path [in] path of the server's Unix socket
+     * @param executor_config [in] buffer settings and double buffering configuration of the server's launcher
+     * @param routing_matrix [in] optional row-major matrix that maps the chain's nchannels_in output channels to the output channels
+     */
+    SharedMemoryLauncher(char const* socket_path, ProcessExecutorConfig const& executor_config, std::vector<float> routing_matrix);
+
+    /**
+     * @brief Destructor; disarms and disconnects
+     */
+    virtual ~SharedMemoryLauncher();
+
+    ////////////////////////////////
+    // ProcessorLauncherInterface methods
+    virtual void process(float const* const* in_buffer, float* const* out_buffer, int nsamples) override;
+    virtual void process(float const* const* in_buffer, float* const* out_buffer, int nsamples, uint8_t const* active_channels) override;
+    virtual void set_inactive_channel_output(InactiveChannelOutput policy) override;
+    virtual void set_inactive_channel_state(InactiveChannelState policy) override;
+    virtual void arm() override;
+    virtual void disarm() override;
+    virtual double warm_up(uint32_t nblocks) override;
+    virtual void render_segmented(float const* const* input, float* const* output, uint32_t nsamples, uint32_t nsegments) override;
+    virtual void load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size, uint32_t tail_samples) override;
+    virtual void save_snapshot(char const* snapshot_path) override;
+    virtual void start_capture(char const* capture_path) override;
+    virtual void stop_capture() override;
+    virtual void set_silence_skipping(bool enable, float threshold) override;
+    virtual void set_deadline(DeadlineConfig const& config) override;
+    virtual void clear_deadline() override;
+    virtual LauncherStatistics get_statistics() const override;
+    virtual MemoryFootprint get_memory_footprint() const override;
+    virtual void set_memory_budget(uint64_t budget_bytes) override;
+    // ProcessorLauncherInterface methods
+    ////////////////////////////////
+
+    ////////////////////////////////
+    // SharedMemoryLauncherInterface methods
+    virtual float* const* acquire_input(uint32_t nsamples) override;
+    virtual float const* const* commit(uint32_t nsamples) override;
+    // SharedMemoryLauncherInterface methods
+    ////////////////////////////////
+
+private:
+    /**
+     * @brief Send a request and wait for the response; throws the server's error
+     */
+    std::vector<std::byte> request(SharedMemoryProtocol::Op op, std::span<std::byte const> payload = {}, int* fd = nullptr) const;
+
+    /**
+     * @brief Let the server process the block in the shared memory and wait for it
+     */
+    void run_block(uint32_t nsamples);
+
+    /**
+     * @brief Get the snapshot of the configuration and the loaded processors
+     */
+    LauncherSnapshot make_snapshot() const;
+
+    int m_socket {-1};
+    uint32_t const m_nchannels_in;
+    uint32_t const m_nchannels_out;
+    ProcessExecutorConfig const m_executor_config;
+    std::vector<float> const m_routing_matrix;
+
+    /**
+     * A processor that is loaded into the server's launcher when arming
+     */
+    struct ProcDesc {
+        std::wstring m_module_id;
+        std::vector<std::byte> m_processor_spec;
+        uint32_t m_tail_samples {0u};
+    };
+    std::vector<ProcDesc> m_processors;
+
+    // the channel activity mask is applied on the client
+    ChannelMask m_channel_mask;
+    InactiveChannelOutput m_inactive_output {InactiveChannelOutput::eZero};
+    InactiveChannelState m_inactive_state {InactiveChannelState::eFrozen};
+    // a block without active channels was skipped under InactiveChannelState::eReset
+    bool m_reset_pending {false};
+
+    // applied by the server before it arms
+    SharedMemoryProtocol::ArmSettings m_settings {};
+
+    bool m_armed {false};
+    void* m_memory {nullptr};
+    size_t m_memory_size {0u};
+    SharedMemoryProtocol::BlockHeader* m_block {nullptr};
+    std::vector<float*> m_input;
+    std::vector<float*> m_output;
+    uint32_t m_acquired_samples {0u};
+};
+
+#endif // GPUA_SHARED_MEMORY_LAUNCHER_H
@@ -0,0 +1,167 @@
+#include "SharedMemoryProtocol.h"
+
+#include <linux/futex.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace SharedMemoryProtocol {
+
+namespace {
+size_t header_size() {
+    return (sizeof(BlockHeader) + 63u) & ~size_t {63u};
+}
+
+void write_all(int socket, void const* data, size_t size) {
+    auto const* bytes = static_cast<char const*>(data);
+    while (size != 0u) {
+        ssize_t const nwritten = ::send(socket, bytes, size, MSG_NOSIGNAL);
+        if (nwritten < 0 && errno == EINTR) {
+            continue;
+        }
+        if (nwritten <= 0) {
+            throw std::runtime_error("Failed to send to the processing server connection");
+        }
+        bytes += nwritten;
+        size -= static_cast<size_t>(nwritten);
+    }
+}
+
+bool read_all(int socket, void* data, size_t size) {
+    auto* bytes = static_cast<char*>(data);
+    while (size != 0u) {
+        ssize_t const nread = ::recv(socket, bytes, size, 0);
+        if (nread < 0 && errno == EINTR) {
+            continue;
+        }
+        if (nread <= 0) {
+            return false;
+        }
+        bytes += nread;
+        size -= static_cast<size_t>(nread);
+    }
+    return true;
+}
+} // namespace
+
+size_t shared_memory_size(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t capacity) {
+    return header_size() + static_cast<size_t>(nchannels_in + nchannels_out) * capacity * sizeof(float);
+}
+
+std::vector<float*> input_channels(BlockHeader* header, uint32_t nchannels_in, uint32_t capacity) {
+    float* data = reinterpret_cast<float*>(reinterpret_cast<std::byte*>(header) + header_size());
+    std::vector<float*> channels(nchannels_in);
+    for (uint32_t ch {0u}; ch < nchannels_in; ++ch) {
+        channels[ch] = data + static_cast<size_t>(ch) * capacity;
+    }
+    return channels;
+}
+
+std::vector<float*> output_channels(BlockHeader* header, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t capacity) {
+    float* data = reinterpret_cast<float*>(reinterpret_cast<std::byte*>(header) + header_size()) + static_cast<size_t>(nchannels_in) * capacity;
+    std::vector<float*> channels(nchannels_out);
+    for (uint32_t ch {0u}; ch < nchannels_out; ++ch) {
+        channels[ch] = data + static_cast<size_t>(ch) * capacity;
+    }
+    return channels;
+}
+
+void send_message(int socket, uint32_t tag, std::span<std::byte const> payload, int fd) {
+    if (payload.size() > MaxPayloadSize) {
+        throw std::runtime_error("Message exceeds the maximum payload size");
+    }
+    uint32_t const header[] {tag, static_cast<uint32_t>(payload.size())};
+
+    // the file descriptor travels as ancillary data of the message header
+    iovec iov {.iov_base = const_cast<uint32_t*>(header), .iov_len = sizeof(header)};
+    msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1u;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+    if (fd >= 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t nwritten;
+    do {
+        nwritten = ::sendmsg(socket, &msg, MSG_NOSIGNAL);
+    } while (nwritten < 0 && errno == EINTR);
+    if (nwritten <= 0) {
+        throw std::runtime_error("Failed to send to the processing server connection");
+    }
+    if (static_cast<size_t>(nwritten) < sizeof(header)) {
+        write_all(socket, reinterpret_cast<char const*>(header) + nwritten, sizeof(header) - static_cast<size_t>(nwritten));
+    }
+    write_all(socket, payload.data(), payload.size());
+}
+
+bool receive_message(int socket, uint32_t& tag, std::vector<std::byte>& payload, int* fd) {
+    uint32_t header[2] {};
+    iovec iov {.iov_base = header, .iov_len = sizeof(header)};
+    msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1u;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t nread;
+    do {
+        nread = ::recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+    } while (nread < 0 && errno == EINTR);
+    if (nread <= 0) {
+        return false;
+    }
+
+    int received_fd {-1};
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            std::memcpy(&received_fd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+    if (fd) {
+        *fd = received_fd;
+    }
+    else if (received_fd >= 0) {
+        ::close(received_fd);
+    }
+
+    if (static_cast<size_t>(nread) < sizeof(header) && !read_all(socket, reinterpret_cast<char*>(header) + nread, sizeof(header) - static_cast<size_t>(nread))) {
+        return false;
+    }
+    tag = header[0];
+    // the stream can't be resynchronized past a payload that is not read; give up on the peer
+    if (header[1] > MaxPayloadSize) {
+        if (fd && *fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+        return false;
+    }
+    payload.resize(header[1]);
+    return read_all(socket, payload.data(), payload.size());
+}
+
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, int timeout_ms) {
+    timespec timeout {.tv_sec = timeout_ms / 1000, .tv_nsec = (timeout_ms % 1000) * 1000000L};
+    // shared futex (no FUTEX_PRIVATE_FLAG); the word lives in memory mapped by two processes
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, timeout_ms < 0 ? nullptr : &timeout, nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& word) {
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace SharedMemoryProtocol
@@ -0,0 +1,132 @@
+#ifndef GPUA_SHARED_MEMORY_PROTOCOL_H
+#define GPUA_SHARED_MEMORY_PROTOCOL_H
+
+#include <ProcessorLauncherInterface.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Protocol between the shared-memory launcher client and the processing server (Linux only).
+ *
+ * Control: length-prefixed messages over a Unix stream socket; a request is an op code and its payload, a response
+ * a status and its payload (an error message if the status is not Ok). The response to eArm carries the file
+ * descriptor of the stream's shared memory.
+ *
+ * Audio: the shared memory of a stream holds a BlockHeader followed by the planar input (nchannels_in x capacity)
+ * and output (nchannels_out x capacity) channels. process() is synchronous, so a block is handed over in place
+ * instead of through a ring: the client writes the input and bumps `request`, the server processes it and bumps
+ * `response` to the same value. Both words are futexes.
+ */
+namespace SharedMemoryProtocol {
+
+enum class Op : uint32_t {
+    // payload: ArmSettings followed by a serialized LauncherSnapshot
+    eArm,
+    eDisarm,
+    // payload: SilenceSkipping
+    eSetSilenceSkipping,
+    // payload: DeadlineConfig
+    eSetDeadline,
+    eClearDeadline,
+    // payload: uint64 budget in bytes
+    eSetMemoryBudget,
+    // payload: path of the capture file on the server's file system
+    eStartCapture,
+    eStopCapture,
+    // payload: uint32 nblocks; response: double median launch duration in microseconds
+    eWarmUp,
+    // response: LauncherStatistics
+    eGetStatistics,
+    // response: MemoryFootprint
+    eGetMemoryFootprint,
+    // recreates the processors; see InactiveChannelState::eReset
+    eResetProcessors
+};
+
+enum class Status : uint32_t {
+    eOk,
+    eError
+};
+
+/**
+ * Payload of eSetSilenceSkipping
+ */
+struct SilenceSkipping {
+    uint32_t enable {0u};
+    float threshold {0.f};
+};
+
+/**
+ * Settings applied to the server's launcher before it is armed
+ */
+struct ArmSettings {
+    uint32_t skip_silence {0u};
+    float silence_threshold {0.f};
+    uint32_t has_deadline {0u};
+    DeadlineConfig deadline {};
+    uint64_t memory_budget {0u};
+};
+
+/**
+ * Start of the shared memory of a stream
+ */
+struct BlockHeader {
+    alignas(64) std::atomic<uint32_t> request {0u};
+    alignas(64) std::atomic<uint32_t> response {0u};
+    alignas(64) uint32_t nsamples {0u};
+    uint32_t failed {0u};
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+
+/**
+ * Largest payload of a message in bytes; bounds what a peer can make the other side allocate
+ */
+constexpr uint32_t MaxPayloadSize {16u << 20u};
+
+/**
+ * @brief Get the size of the shared memory of a stream
+ */
+size_t shared_memory_size(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t capacity);
+
+/**
+ * @brief Get the channels of the shared memory of a stream
+ */
+std::vector<float*> input_channels(BlockHeader* header, uint32_t nchannels_in, uint32_t capacity);
+std::vector<float*> output_channels(BlockHeader* header, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t capacity);
+
+/**
+ * @brief Send a message; throws if the socket was closed
+ * @param socket [in] connected socket
+ * @param tag [in] op code of a request or status of a response
+ * @param payload [in] payload of the message; throws if it exceeds MaxPayloadSize
+ * @param fd [in] file descriptor to pass along; -1 if there is none
+ */
+void send_message(int socket, uint32_t tag, std::span<std::byte const> payload, int fd = -1);
+
+/**
+ * @brief Receive a message
+ * @param socket [in] connected socket
+ * @param tag [out] op code of a request or status of a response
+ * @param payload [out] payload of the message
+ * @param fd [out] optional; file descriptor passed along with the message or -1
+ * @return false if the peer closed the connection or announced a payload larger than MaxPayloadSize
+ */
+bool receive_message(int socket, uint32_t& tag, std::vector<std::byte>& payload, int* fd = nullptr);
+
+/**
+ * @brief Sleep while `word` holds `expected`, at most timeout_ms milliseconds; may return spuriously
+ */
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, int timeout_ms);
+
+/**
+ * @brief Wake all threads and processes sleeping on `word`
+ */
+void futex_wake(std::atomic<uint32_t>& word);
+
+} // namespace SharedMemoryProtocol
+
+#endif // GPUA_SHARED_MEMORY_PROTOCOL_H
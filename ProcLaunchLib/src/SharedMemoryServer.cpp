@@ -0,0 +1,329 @@
+#include "SharedMemoryServer.h"
+
+#include "LauncherSnapshot.h"
+#include "ProcessingThread.h"
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+
+using namespace SharedMemoryProtocol;
+
+namespace {
+template <typename T>
+T read_payload(std::vector<std::byte> const& payload) {
+    if (payload.size() < sizeof(T)) {
+        throw std::runtime_error("Malformed request");
+    }
+    T value;
+    std::memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+
+template <typename T>
+void write_payload(std::vector<std::byte>& response, T const& value) {
+    std::byte const* bytes = reinterpret_cast<std::byte const*>(&value);
+    response.assign(bytes, bytes + sizeof(T));
+}
+} // namespace
+
+SharedMemoryServer::SharedMemoryServer(char const* socket_path, char const* capture_directory) :
+    m_socket_path {socket_path},
+    m_capture_directory {capture_directory ? capture_directory : ""} {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (m_socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long");
+    }
+    std::memcpy(address.sun_path, m_socket_path.c_str(), m_socket_path.size() + 1u);
+
+    m_socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_socket < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+    ::unlink(m_socket_path.c_str());
+    // only processes of the server's user may connect, independent of the umask
+    if (::bind(m_socket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 || ::chmod(m_socket_path.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+        ::listen(m_socket, SOMAXCONN) != 0) {
+        ::close(m_socket);
+        throw std::runtime_error("Failed to bind socket");
+    }
+}
+
+SharedMemoryServer::~SharedMemoryServer() {
+    stop();
+    reap_connections(true);
+    ::close(m_socket);
+    ::unlink(m_socket_path.c_str());
+}
+
+void SharedMemoryServer::run() {
+    while (!m_stop.load()) {
+        int const client = ::accept4(m_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            // stop() shut the socket down
+            if (m_stop.load()) {
+                break;
+            }
+            // e.g., out of descriptors; finished connections free some, so retry after a pause
+            if (errno != EINTR && errno != ECONNABORTED) {
+                reap_connections(false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+
+        reap_connections(false);
+
+        auto connection = std::make_unique<Connection>();
+        connection->m_socket = client;
+        Connection* raw_connection = connection.get();
+        std::lock_guard<std::mutex> lock(m_connections_mutex);
+        m_connections.push_back(std::move(connection));
+        raw_connection->m_thread = std::thread(&SharedMemoryServer::serve, this, raw_connection);
+    }
+}
+
+void SharedMemoryServer::stop() {
+    m_stop.store(true);
+    // wakes up accept()
+    ::shutdown(m_socket, SHUT_RDWR);
+
+    // wake up all connections waiting for requests
+    std::lock_guard<std::mutex> lock(m_connections_mutex);
+    for (auto const& connection : m_connections) {
+        ::shutdown(connection->m_socket, SHUT_RDWR);
+    }
+}
+
+void SharedMemoryServer::reap_connections(bool all) {
+    std::list<std::unique_ptr<Connection>> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_connections_mutex);
+        for (auto it = m_connections.begin(); it != m_connections.end();) {
+            if (all || (*it)->m_done.load()) {
+                finished.push_back(std::move(*it));
+                it = m_connections.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    for (auto& connection : finished) {
+        connection->m_thread.join();
+        // closed only now s.t. stop() never shuts down a descriptor number that was reused
+        ::close(connection->m_socket);
+    }
+}
+
+void SharedMemoryServer::serve(Connection* connection) {
+    uint32_t tag {0u};
+    std::vector<std::byte> payload;
+    std::vector<std::byte> response;
+    while (receive_message(connection->m_socket, tag, payload)) {
+        response.clear();
+        Status status {Status::eOk};
+        try {
+            handle_request(connection, static_cast<Op>(tag), payload, response);
+        }
+        catch (std::exception const& e) {
+            status = Status::eError;
+            std::string const message = e.what();
+            response.assign(reinterpret_cast<std::byte const*>(message.data()), reinterpret_cast<std::byte const*>(message.data() + message.size()));
+        }
+
+        try {
+            send_message(connection->m_socket, static_cast<uint32_t>(status), response, static_cast<Op>(tag) == Op::eArm && status == Status::eOk ? connection->m_memory_fd : -1);
+        }
+        catch (...) {
+            break;
+        }
+    }
+
+    // the client disconnected, broke the protocol or the server stops; the client sees the disconnect right away, the
+    // descriptor is closed when the connection is reaped
+    ::shutdown(connection->m_socket, SHUT_RDWR);
+    try {
+        disarm(connection);
+    }
+    catch (...) {
+    }
+    connection->m_done.store(true);
+}
+
+void SharedMemoryServer::handle_request(Connection* connection, Op op, std::vector<std::byte> const& payload, std::vector<std::byte>& response) {
+    if (op == Op::eArm) {
+        arm(connection, payload);
+        return;
+    }
+    if (op == Op::eDisarm) {
+        disarm(connection);
+        return;
+    }
+    if (!connection->m_armed) {
+        throw std::runtime_error("Processing server stream is not armed");
+    }
+
+    // a well-behaved client doesn't send requests while a block is pending; don't rely on it
+    std::lock_guard<std::mutex> lock(connection->m_launcher_mutex);
+    GPUProcessorLauncher& launcher = *connection->m_launcher;
+    switch (op) {
+    case Op::eSetSilenceSkipping: {
+        SilenceSkipping const request = read_payload<SilenceSkipping>(payload);
+        launcher.set_silence_skipping(request.enable != 0u, request.threshold);
+        break;
+    }
+    case Op::eSetDeadline:
+        launcher.set_deadline(read_payload<DeadlineConfig>(payload));
+        break;
+    case Op::eClearDeadline:
+        launcher.clear_deadline();
+        break;
+    case Op::eSetMemoryBudget:
+        launcher.set_memory_budget(read_payload<uint64_t>(payload));
+        break;
+    case Op::eStartCapture: {
+        std::string const name(reinterpret_cast<char const*>(payload.data()), payload.size());
+        launcher.start_capture(capture_path(name).c_str());
+        break;
+    }
+    case Op::eStopCapture:
+        launcher.stop_capture();
+        break;
+    case Op::eWarmUp:
+        write_payload(response, launcher.warm_up(read_payload<uint32_t>(payload)));
+        break;
+    case Op::eGetStatistics:
+        write_payload(response, launcher.get_statistics());
+        break;
+    case Op::eGetMemoryFootprint:
+        write_payload(response, launcher.get_memory_footprint());
+        break;
+    case Op::eResetProcessors:
+        launcher.reset_processors();
+        break;
+    default:
+        throw std::runtime_error("Unknown processing server request");
+    }
+}
+
+void SharedMemoryServer::arm(Connection* connection, std::vector<std::byte> const& payload) {
+    if (connection->m_armed) {
+        return;
+    }
+
+    ArmSettings const settings = read_payload<ArmSettings>(payload);
+    LauncherSnapshot const snapshot = LauncherSnapshot::parse(std::span<std::byte const>(payload).subspan(sizeof(ArmSettings)));
+
+    auto launcher = std::make_unique<GPUProcessorLauncher>(snapshot.m_executor_config, snapshot.m_routing_matrix);
+    launcher->load_processors(snapshot.m_processors);
+    launcher->set_silence_skipping(settings.skip_silence != 0u, settings.silence_threshold);
+    if (settings.has_deadline != 0u) {
+        launcher->set_deadline(settings.deadline);
+    }
+    launcher->set_memory_budget(settings.memory_budget);
+    launcher->arm();
+
+    // the shared memory of the stream; the client maps the same file
+    uint32_t const nchannels_in = snapshot.m_executor_config.nchannels_in;
+    uint32_t const nchannels_out = snapshot.m_routing_matrix.empty() ? snapshot.m_executor_config.nchannels_out : static_cast<uint32_t>(snapshot.m_routing_matrix.size() / nchannels_in);
+    uint32_t const capacity = snapshot.m_executor_config.max_samples_per_channel;
+    size_t const memory_size = shared_memory_size(nchannels_in, nchannels_out, capacity);
+    int const memory_fd = ::memfd_create("gpua-stream", MFD_CLOEXEC);
+    if (memory_fd < 0) {
+        throw std::runtime_error("Failed to create shared memory");
+    }
+    void* memory = MAP_FAILED;
+    if (::ftruncate(memory_fd, static_cast<off_t>(memory_size)) == 0) {
+        memory = ::mmap(nullptr, memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    }
+    if (memory == MAP_FAILED) {
+        ::close(memory_fd);
+        throw std::runtime_error("Failed to map shared memory");
+    }
+
+    connection->m_launcher = std::move(launcher);
+    connection->m_nchannels_in = nchannels_in;
+    connection->m_nchannels_out = nchannels_out;
+    connection->m_capacity = capacity;
+    connection->m_memory_fd = memory_fd;
+    connection->m_memory_size = memory_size;
+    connection->m_block = new (memory) BlockHeader {};
+    connection->m_stop_blocks.store(false);
+    connection->m_block_thread = start_processing_thread("gpua-server", [this, connection] { block_loop(connection); });
+    connection->m_armed = true;
+}
+
+void SharedMemoryServer::disarm(Connection* connection) {
+    if (!connection->m_armed) {
+        return;
+    }
+    connection->m_armed = false;
+
+    // a changed request word wakes up the block thread, which then sees the stop flag
+    connection->m_stop_blocks.store(true);
+    connection->m_block->request.fetch_add(1u);
+    futex_wake(connection->m_block->request);
+    connection->m_block_thread.join();
+
+    ::munmap(connection->m_block, connection->m_memory_size);
+    ::close(connection->m_memory_fd);
+    connection->m_block = nullptr;
+    connection->m_memory_fd = -1;
+    connection->m_launcher.reset();
+}
+
+void SharedMemoryServer::block_loop(Connection* connection) {
+    BlockHeader& block = *connection->m_block;
+    std::vector<float*> const input = input_channels(&block, connection->m_nchannels_in, connection->m_capacity);
+    std::vector<float*> const output = output_channels(&block, connection->m_nchannels_in, connection->m_nchannels_out, connection->m_capacity);
+
+    // start from the freshly constructed header; the client may post its first block before this thread runs
+    uint32_t handled {0u};
+    while (true) {
+        futex_wait(block.request, handled, -1);
+        if (connection->m_stop_blocks.load()) {
+            return;
+        }
+        uint32_t const request = block.request.load(std::memory_order_acquire);
+        if (request == handled) {
+            continue;
+        }
+        handled = request;
+
+        uint32_t failed {0u};
+        try {
+            std::lock_guard<std::mutex> lock(connection->m_launcher_mutex);
+            connection->m_launcher->process(input.data(), output.data(), static_cast<int>(std::min(block.nsamples, connection->m_capacity)));
+        }
+        catch (...) {
+            failed = 1u;
+        }
+        block.failed = failed;
+        block.response.store(request, std::memory_order_release);
+        futex_wake(block.response);
+    }
+}
+
+std::string SharedMemoryServer::capture_path(std::string const& name) const {
+    if (m_capture_directory.empty()) {
+        throw std::runtime_error("Processing server doesn't accept captures");
+    }
+    // a plain file name; clients can't write outside the capture directory
+    if (name.empty() || name == "." || name == ".." || name.find_first_of(std::string_view("/\0", 2u)) != std::string::npos) {
+        throw std::runtime_error("Capture name must be a file name");
+    }
+    return (std::filesystem::path(m_capture_directory) / name).string();
+}
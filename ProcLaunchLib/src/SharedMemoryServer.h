@@ -0,0 +1,90 @@
+#ifndef GPUA_SHARED_MEMORY_SERVER_H
+#define GPUA_SHARED_MEMORY_SERVER_H
+
+#include <ProcessingServerInterface.h>
+
+#include "GPUProcessorLauncher.h"
+#include "SharedMemoryProtocol.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Local processing server (Linux only). Clients connect over a Unix socket; every armed client gets a launcher of its
+ * own whose blocks are processed on a dedicated processing thread, which picks them up straight from the shared memory.
+ * All launchers share the process' engine context, but blocks of different clients are not batched into common launches.
+ * See SharedMemoryProtocol. Implements the ProcessingServerInterface.
+ */
+class SharedMemoryServer : public ProcessingServerInterface {
+public:
+    /**
+     * @brief Constructor; creates and binds the socket
+     * @param socket_path [in] path of the Unix socket; an existing socket file is replaced. Only the server's user may connect.
+     * @param capture_directory [in] directory the captures of the clients are written to; nullptr rejects captures
+     */
+    SharedMemoryServer(char const* socket_path, char const* capture_directory);
+
+    /**
+     * @brief Destructor; stops serving, disconnects all clients and removes the socket file
+     */
+    virtual ~SharedMemoryServer();
+
+    SharedMemoryServer(SharedMemoryServer const&) = delete;
+    SharedMemoryServer& operator=(SharedMemoryServer const&) = delete;
+
+    ////////////////////////////////
+    // ProcessingServerInterface methods
+    virtual void run() override;
+    virtual void stop() override;
+    // ProcessingServerInterface methods
+    ////////////////////////////////
+
+private:
+    /**
+     * A connected client and its stream
+     */
+    struct Connection {
+        int m_socket {-1};
+        std::thread m_thread;
+        std::atomic<bool> m_done {false};
+
+        // valid while armed
+        bool m_armed {false};
+        std::unique_ptr<GPUProcessorLauncher> m_launcher;
+        // held by the block thread while it processes and by requests that use the launcher
+        std::mutex m_launcher_mutex;
+        uint32_t m_nchannels_in {0u};
+        uint32_t m_nchannels_out {0u};
+        uint32_t m_capacity {0u};
+        int m_memory_fd {-1};
+        size_t m_memory_size {0u};
+        SharedMemoryProtocol::BlockHeader* m_block {nullptr};
+        std::thread m_block_thread;
+        std::atomic<bool> m_stop_blocks {false};
+    };
+
+    void serve(Connection* connection);
+    void handle_request(Connection* connection, SharedMemoryProtocol::Op op, std::vector<std::byte> const& payload, std::vector<std::byte>& response);
+    void arm(Connection* connection, std::vector<std::byte> const& payload);
+    void disarm(Connection* connection);
+    void block_loop(Connection* connection);
+    std::string capture_path(std::string const& name) const;
+    void reap_connections(bool all);
+
+    std::string m_socket_path;
+    // empty if captures are rejected
+    std::string m_capture_directory;
+    int m_socket {-1};
+    std::atomic<bool> m_stop {false};
+
+    std::mutex m_connections_mutex;
+    std::list<std::unique_ptr<Connection>> m_connections;
+};
+
+#endif // GPUA_SHARED_MEMORY_SERVER_H
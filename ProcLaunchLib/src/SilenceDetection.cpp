@@ -0,0 +1,61 @@
+#include "SilenceDetection.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GPUA_SILENCE_DETECTION_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GPUA_SILENCE_DETECTION_NEON
+#endif
+
+namespace {
+bool is_channel_silent(float const* data, uint32_t nsamples, float threshold) {
+    uint32_t s {0u};
+
+#if defined(GPUA_SILENCE_DETECTION_SSE2)
+    __m128 const abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 const thresh = _mm_set1_ps(threshold);
+    // compare 16 samples per iteration; `not less-equal` is also true for NaNs
+    for (; s + 16u <= nsamples; s += 16u) {
+        __m128 loud = _mm_cmpnle_ps(_mm_and_ps(_mm_loadu_ps(data + s), abs_mask), thresh);
+        loud = _mm_or_ps(loud, _mm_cmpnle_ps(_mm_and_ps(_mm_loadu_ps(data + s + 4u), abs_mask), thresh));
+        loud = _mm_or_ps(loud, _mm_cmpnle_ps(_mm_and_ps(_mm_loadu_ps(data + s + 8u), abs_mask), thresh));
+        loud = _mm_or_ps(loud, _mm_cmpnle_ps(_mm_and_ps(_mm_loadu_ps(data + s + 12u), abs_mask), thresh));
+        if (_mm_movemask_ps(loud) != 0) {
+            return false;
+        }
+    }
+#elif defined(GPUA_SILENCE_DETECTION_NEON)
+    float32x4_t const thresh = vdupq_n_f32(threshold);
+    // compare 16 samples per iteration; `less-equal` is false for NaNs
+    for (; s + 16u <= nsamples; s += 16u) {
+        uint32x4_t quiet = vcleq_f32(vabsq_f32(vld1q_f32(data + s)), thresh);
+        quiet = vandq_u32(quiet, vcleq_f32(vabsq_f32(vld1q_f32(data + s + 4u)), thresh));
+        quiet = vandq_u32(quiet, vcleq_f32(vabsq_f32(vld1q_f32(data + s + 8u)), thresh));
+        quiet = vandq_u32(quiet, vcleq_f32(vabsq_f32(vld1q_f32(data + s + 12u)), thresh));
+        if (vminvq_u32(quiet) == 0u) {
+            return false;
+        }
+    }
+#endif
+
+    // remaining samples (or all of them without SIMD support)
+    for (; s < nsamples; ++s) {
+        if (!(std::fabs(data[s]) <= threshold)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool is_silent(float const* const* channels, uint32_t nchannels, uint32_t nsamples, float threshold) {
+    for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+        if (!is_channel_silent(channels[ch], nsamples, threshold)) {
+            return false;
+        }
+    }
+    return true;
+}
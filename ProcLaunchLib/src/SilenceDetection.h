@@ -0,0 +1,17 @@
+#ifndef GPUA_SILENCE_DETECTION_H
+#define GPUA_SILENCE_DETECTION_H
+
+#include <cstdint>
+
+/**
+ * @brief Check whether all samples of all channels are silent, i.e., their absolute value does not exceed the threshold.
+ * NaNs are never considered silent.
+ * @param channels [in] pointer to pointers to the channels of the audio data
+ * @param nchannels [in] number of channels
+ * @param nsamples [in] number of samples per channel
+ * @param threshold [in] largest absolute sample value that still counts as silence
+ * @return true if the block is silent
+ */
+bool is_silent(float const* const* channels, uint32_t nchannels, uint32_t nsamples, float threshold);
+
+#endif // GPUA_SILENCE_DETECTION_H
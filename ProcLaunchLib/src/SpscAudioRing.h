@@ -0,0 +1,112 @@
+#ifndef GPUA_SPSC_AUDIO_RING_H
+#define GPUA_SPSC_AUDIO_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Lock-free single-producer/single-consumer ring of planar multi-channel audio.
+ * All channels share the read and write positions; the capacity is rounded up to a power of two.
+ */
+class SpscAudioRing {
+public:
+    /**
+     * @brief Constructor
+     * @param nchannels [in] number of channels
+     * @param capacity [in] minimum number of samples per channel the ring can hold
+     */
+    SpscAudioRing(uint32_t nchannels, uint32_t capacity) :
+        m_nchannels {nchannels},
+        m_capacity {std::bit_ceil(std::max(capacity, 1u))},
+        m_data(static_cast<size_t>(m_nchannels) * m_capacity, 0.f) {
+    }
+
+    /**
+     * @brief Number of samples per channel the ring can hold
+     */
+    uint32_t capacity() const {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Number of samples per channel that can be read; exact on the consumer side
+     */
+    uint32_t read_available() const {
+        return static_cast<uint32_t>(m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Number of samples per channel that can be written; exact on the producer side
+     */
+    uint32_t write_available() const {
+        return m_capacity - read_available();
+    }
+
+    /**
+     * @brief Append samples; producer side only
+     * @param src [in] pointer to pointers to the channels to append; nullptr appends silence
+     * @param nsamples [in] number of samples per channel to append
+     * @return number of samples per channel that were appended
+     */
+    uint32_t write(float const* const* src, uint32_t nsamples) {
+        uint64_t const write_pos = m_write_pos.load(std::memory_order_relaxed);
+        uint32_t const nwrite = std::min(nsamples, m_capacity - static_cast<uint32_t>(write_pos - m_read_pos.load(std::memory_order_acquire)));
+        transfer(write_pos, nwrite, [&](float* ring, uint32_t ch, uint32_t src_off, uint32_t n) {
+            if (src) {
+                std::memcpy(ring, src[ch] + src_off, n * sizeof(float));
+            }
+            else {
+                std::fill_n(ring, n, 0.f);
+            }
+        });
+        m_write_pos.store(write_pos + nwrite, std::memory_order_release);
+        return nwrite;
+    }
+
+    /**
+     * @brief Remove samples; consumer side only
+     * @param dst [in/out] pointer to pointers to the channels to copy the samples to
+     * @param nsamples [in] number of samples per channel to remove
+     * @return number of samples per channel that were removed
+     */
+    uint32_t read(float* const* dst, uint32_t nsamples) {
+        uint64_t const read_pos = m_read_pos.load(std::memory_order_relaxed);
+        uint32_t const nread = std::min(nsamples, static_cast<uint32_t>(m_write_pos.load(std::memory_order_acquire) - read_pos));
+        transfer(read_pos, nread, [&](float* ring, uint32_t ch, uint32_t dst_off, uint32_t n) {
+            std::memcpy(dst[ch] + dst_off, ring, n * sizeof(float));
+        });
+        m_read_pos.store(read_pos + nread, std::memory_order_release);
+        return nread;
+    }
+
+private:
+    /**
+     * @brief Call `copy` for the (up to two) contiguous ring regions of every channel that cover [pos, pos + nsamples)
+     */
+    template <typename Copy>
+    void transfer(uint64_t pos, uint32_t nsamples, Copy&& copy) {
+        uint32_t const start = static_cast<uint32_t>(pos & (m_capacity - 1u));
+        uint32_t const first = std::min(nsamples, m_capacity - start);
+        for (uint32_t ch {0u}; ch < m_nchannels; ++ch) {
+            float* channel = m_data.data() + static_cast<size_t>(ch) * m_capacity;
+            copy(channel + start, ch, 0u, first);
+            if (first < nsamples) {
+                copy(channel, ch, first, nsamples - first);
+            }
+        }
+    }
+
+    uint32_t const m_nchannels;
+    uint32_t const m_capacity;
+    std::vector<float> m_data;
+
+    // monotonic positions; separate cache lines s.t. producer and consumer don't share one
+    alignas(64) std::atomic<uint64_t> m_write_pos {0u};
+    alignas(64) std::atomic<uint64_t> m_read_pos {0u};
+};
+
+#endif // GPUA_SPSC_AUDIO_RING_H
@@ -0,0 +1,112 @@
+#include "StreamingFrontEnd.h"
+
+#include "ProcessingThread.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+StreamingFrontEnd::StreamingFrontEnd(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t block_size, uint32_t safety_margin) :
+    m_launcher {std::move(launcher)},
+    m_nchannels_in {nchannels_in},
+    m_nchannels_out {nchannels_out},
+    m_block_size {block_size},
+    // leave room for the margin plus a few blocks of jitter in both directions
+    m_input(nchannels_in, safety_margin + 4u * block_size),
+    m_output(nchannels_out, safety_margin + 4u * block_size),
+    m_block((static_cast<size_t>(nchannels_in) + nchannels_out) * block_size),
+    m_block_in(nchannels_in),
+    m_block_out(nchannels_out) {
+    if (!m_launcher) {
+        throw std::runtime_error("Error StreamingFrontEnd created without launcher");
+    }
+    if (m_block_size == 0u) {
+        throw std::runtime_error("Error StreamingFrontEnd created with a block size of 0");
+    }
+
+    for (uint32_t ch {0u}; ch < m_nchannels_in; ++ch) {
+        m_block_in[ch] = m_block.data() + static_cast<size_t>(ch) * m_block_size;
+    }
+    for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+        m_block_out[ch] = m_block.data() + static_cast<size_t>(m_nchannels_in + ch) * m_block_size;
+    }
+
+    // the callback consumes the margin while the first blocks are processed
+    m_output.write(nullptr, safety_margin);
+    m_min_output_fill = m_output.read_available();
+
+    // arm before the first block arrives to keep the arming cost out of the stream
+    m_launcher->arm();
+
+    m_thread = start_processing_thread("gpua-frontend", [this] { processing_loop(); });
+}
+
+StreamingFrontEnd::~StreamingFrontEnd() {
+    m_stop = true;
+    wake_up();
+    m_thread.join();
+}
+
+uint32_t StreamingFrontEnd::push_input(float const* const* input, uint32_t nsamples) {
+    uint32_t const nwritten = m_input.write(input, nsamples);
+    if (nwritten < nsamples) {
+        m_overruns.fetch_add(1u, std::memory_order_relaxed);
+    }
+    wake_up();
+    return nwritten;
+}
+
+uint32_t StreamingFrontEnd::pull_output(float* const* output, uint32_t nsamples) {
+    uint32_t const fill = m_output.read_available();
+    if (fill < m_min_output_fill.load(std::memory_order_relaxed)) {
+        m_min_output_fill.store(fill, std::memory_order_relaxed);
+    }
+
+    uint32_t const nread = m_output.read(output, nsamples);
+    if (nread < nsamples) {
+        for (uint32_t ch {0u}; ch < m_nchannels_out; ++ch) {
+            std::fill_n(output[ch] + nread, nsamples - nread, 0.f);
+        }
+        m_underruns.fetch_add(1u, std::memory_order_relaxed);
+    }
+    wake_up();
+    return nread;
+}
+
+StreamingStatistics StreamingFrontEnd::get_statistics() const {
+    return {
+        .underruns = m_underruns.load(std::memory_order_relaxed),
+        .overruns = m_overruns.load(std::memory_order_relaxed),
+        .failed_blocks = m_failed_blocks.load(std::memory_order_relaxed),
+        .input_fill = m_input.read_available(),
+        .output_fill = m_output.read_available(),
+        .min_output_fill = m_min_output_fill.load(std::memory_order_relaxed)};
+}
+
+void StreamingFrontEnd::processing_loop() {
+    while (!m_stop.load()) {
+        // remember the wake-up counter before checking for work to not miss a push or pull in between
+        uint32_t const wakeups = m_wakeups.load();
+
+        if (m_input.read_available() < m_block_size || m_output.write_available() < m_block_size) {
+            m_wakeups.wait(wakeups);
+            continue;
+        }
+
+        m_input.read(m_block_in.data(), m_block_size);
+        try {
+            m_launcher->process(m_block_in.data(), m_block_out.data(), static_cast<int>(m_block_size));
+        }
+        catch (...) {
+            for (float* channel : m_block_out) {
+                std::fill_n(channel, m_block_size, 0.f);
+            }
+            m_failed_blocks.fetch_add(1u, std::memory_order_relaxed);
+        }
+        m_output.write(m_block_out.data(), m_block_size);
+    }
+}
+
+void StreamingFrontEnd::wake_up() {
+    m_wakeups.fetch_add(1u);
+    m_wakeups.notify_one();
+}
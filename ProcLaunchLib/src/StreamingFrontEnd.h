@@ -0,0 +1,72 @@
+#ifndef GPUA_STREAMING_FRONT_END_H
+#define GPUA_STREAMING_FRONT_END_H
+
+#include <ProcessorLauncherInterface.h>
+#include <StreamingFrontEndInterface.h>
+
+#include "SpscAudioRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Streaming front-end that drives a launcher from a dedicated processing thread; implements the StreamingFrontEndInterface
+ */
+class StreamingFrontEnd : public StreamingFrontEndInterface {
+public:
+    /**
+     * @brief Constructor; primes the output with `safety_margin` samples of silence and starts the processing thread
+     * @param launcher [in] configured launcher that processes the stream
+     * @param nchannels_in [in] number of channels of the input audio data
+     * @param nchannels_out [in] number of channels of the output audio data
+     * @param block_size [in] number of samples per channel the processing thread passes to the launcher at once
+     * @param safety_margin [in] latency in samples per channel the launches may take without causing an underrun
+     */
+    StreamingFrontEnd(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t block_size, uint32_t safety_margin);
+
+    /**
+     * @brief Destructor; stops the processing thread
+     */
+    virtual ~StreamingFrontEnd();
+
+    ////////////////////////////////
+    // StreamingFrontEndInterface methods
+    virtual uint32_t push_input(float const* const* input, uint32_t nsamples) override;
+    virtual uint32_t pull_output(float* const* output, uint32_t nsamples) override;
+    virtual StreamingStatistics get_statistics() const override;
+    // StreamingFrontEndInterface methods
+    ////////////////////////////////
+
+private:
+    void processing_loop();
+    void wake_up();
+
+    std::unique_ptr<ProcessorLauncherInterface> m_launcher;
+    uint32_t const m_nchannels_in;
+    uint32_t const m_nchannels_out;
+    uint32_t const m_block_size;
+
+    SpscAudioRing m_input;
+    SpscAudioRing m_output;
+
+    // planar input and output block the processing thread moves between the rings and the launcher
+    std::vector<float> m_block;
+    std::vector<float*> m_block_in;
+    std::vector<float*> m_block_out;
+
+    // bumped by every push and pull; the processing thread sleeps on it while it can't make progress
+    std::atomic<uint32_t> m_wakeups {0u};
+    std::atomic<bool> m_stop {false};
+
+    std::atomic<uint64_t> m_underruns {0u};
+    std::atomic<uint64_t> m_overruns {0u};
+    std::atomic<uint64_t> m_failed_blocks {0u};
+    std::atomic<uint32_t> m_min_output_fill {0u};
+
+    std::thread m_thread;
+};
+
+#endif // GPUA_STREAMING_FRONT_END_H
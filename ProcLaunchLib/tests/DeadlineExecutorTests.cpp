@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "TestCommon.h"
+
+#include <DeadlineExecutor.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr uint32_t nchannels {2u};
+constexpr uint32_t nsamples {64u};
+constexpr uint32_t deadline_us {50000u};
+constexpr auto slow_launch {std::chrono::milliseconds(200)};
+
+// doubles the input; sleeps past the deadline while slow is set and throws while fail is set
+struct TestProcess {
+    std::atomic<bool>& slow;
+    std::atomic<bool>& fail;
+
+    void operator()(float const* const* input, float* const* output, uint32_t n) const {
+        if (fail) {
+            throw std::runtime_error("launch failed");
+        }
+        if (slow) {
+            std::this_thread::sleep_for(slow_launch);
+        }
+        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+            for (uint32_t i {0u}; i < n; ++i) {
+                output[ch][i] = 2.f * input[ch][i];
+            }
+        }
+    }
+};
+
+void ExpectChannels(TestData const& actual, TestData const& expected, float scale) {
+    for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+        for (uint32_t i {0u}; i < nsamples; ++i) {
+            ASSERT_EQ(actual.m_data[ch][i], scale * expected.m_data[ch][i]);
+        }
+    }
+}
+} // namespace
+
+class DeadlineExecutorPolicy : public ::testing::TestWithParam<DeadlinePolicy> {};
+
+TEST_P(DeadlineExecutorPolicy, MissedDeadlineAppliesPolicy) {
+    auto const policy = GetParam();
+    std::atomic<bool> slow {false};
+    std::atomic<bool> fail {false};
+    DeadlineExecutor executor(nchannels, nchannels, DeadlineConfig {.policy = policy, .deadline_us = deadline_us}, TestProcess {slow, fail});
+
+    TestData first(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData second(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+
+    ASSERT_TRUE(executor.process(first.m_data, output.m_data, nsamples));
+    ExpectChannels(output, first, 2.f);
+
+    slow = true;
+    ASSERT_FALSE(executor.process(second.m_data, output.m_data, nsamples));
+    // the late result never reaches the caller's buffers
+    executor.wait_idle();
+    switch (policy) {
+    case DeadlinePolicy::ePassThrough:
+        ExpectChannels(output, second, 1.f);
+        break;
+    case DeadlinePolicy::eSilence:
+        ExpectChannels(output, second, 0.f);
+        break;
+    case DeadlinePolicy::eHoldPrevious:
+        ExpectChannels(output, first, 2.f);
+        break;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DeadlineExecutor, DeadlineExecutorPolicy,
+    ::testing::Values(DeadlinePolicy::ePassThrough, DeadlinePolicy::eSilence, DeadlinePolicy::eHoldPrevious));
+
+TEST(DeadlineExecutor, BusyAndPredictedBlocksMiss) {
+    std::atomic<bool> slow {true};
+    std::atomic<bool> fail {false};
+    DeadlineExecutor executor(nchannels, nchannels, DeadlineConfig {.policy = DeadlinePolicy::eSilence, .deadline_us = deadline_us}, TestProcess {slow, fail});
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+
+    // late, then still busy with the late block
+    ASSERT_FALSE(executor.process(input.m_data, output.m_data, nsamples));
+    ASSERT_FALSE(executor.process(input.m_data, output.m_data, nsamples));
+    executor.wait_idle();
+
+    // the slow launch is the only one in the history and predicts a miss; the fast launch of the predicted block
+    // brings the median back below the deadline
+    slow = false;
+    ASSERT_FALSE(executor.process(input.m_data, output.m_data, nsamples));
+    executor.wait_idle();
+    ASSERT_TRUE(executor.process(input.m_data, output.m_data, nsamples));
+    ExpectChannels(output, input, 2.f);
+}
+
+TEST(DeadlineExecutor, SingleSlowLaunchPredictsNoMiss) {
+    std::atomic<bool> slow {false};
+    std::atomic<bool> fail {false};
+    DeadlineExecutor executor(nchannels, nchannels, DeadlineConfig {.policy = DeadlinePolicy::eSilence, .deadline_us = deadline_us}, TestProcess {slow, fail});
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+
+    for (uint32_t b_id {0u}; b_id < 4u; ++b_id) {
+        ASSERT_TRUE(executor.process(input.m_data, output.m_data, nsamples));
+    }
+
+    slow = true;
+    ASSERT_FALSE(executor.process(input.m_data, output.m_data, nsamples));
+    executor.wait_idle();
+
+    // one outlier among fast launches doesn't make the following blocks miss
+    slow = false;
+    for (uint32_t b_id {0u}; b_id < 4u; ++b_id) {
+        ASSERT_TRUE(executor.process(input.m_data, output.m_data, nsamples));
+        ExpectChannels(output, input, 2.f);
+    }
+}
+
+TEST(DeadlineExecutor, FailedLaunchMissesAndRethrows) {
+    std::atomic<bool> slow {false};
+    std::atomic<bool> fail {true};
+    DeadlineExecutor executor(nchannels, nchannels, DeadlineConfig {.policy = DeadlinePolicy::ePassThrough, .deadline_us = deadline_us}, TestProcess {slow, fail});
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+
+    ASSERT_FALSE(executor.process(input.m_data, output.m_data, nsamples));
+    ExpectChannels(output, input, 1.f);
+
+    fail = false;
+    EXPECT_THROW(executor.process(input.m_data, output.m_data, nsamples), std::runtime_error);
+    ASSERT_TRUE(executor.process(input.m_data, output.m_data, nsamples));
+    ExpectChannels(output, input, 2.f);
+}
@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 
+#include "FirSpecification.h"
 #include "GainSpecification.h"
 #include "TestCommon.h"
 
 #include <GPUCreate.h>
 
+#include <filesystem>
+#include <stdexcept>
+
 namespace {
 void apply_gain(TestData& data, float gain) {
     for (uint32_t ch {0u}; ch < data.m_nchannels; ++ch) {
@@ -19,3 +23,460 @@ TEST(ProcLaunchLib, CreateDestroy) {
     std::unique_ptr<ProcessorLauncherInterface> ProcLaunchLib = createGpuProcessorLauncher(2u, 256u);
     ASSERT_NE(ProcLaunchLib, nullptr);
 }
+
+TEST(ProcLaunchLib, SnapshotRoundTrip) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    std::string const snapshot_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_SnapshotRoundTrip.bin").string();
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    for (float gain : {0.5f, 3.f}) {
+        GainConfig::Specification gain_spec {.params {.gain_value = gain}};
+        launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    }
+    launcher->save_snapshot(snapshot_path.c_str());
+
+    auto restored = createGpuProcessorLauncherFromSnapshot(snapshot_path.c_str());
+    ASSERT_NE(restored, nullptr);
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData expected {input}, output {input};
+    launcher->process(input(), expected(), nsamples);
+    restored->process(input(), output(), nsamples);
+    EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u));
+
+    apply_gain(input, 1.5f);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+
+    std::filesystem::remove(snapshot_path);
+}
+
+TEST(ProcLaunchLib, SnapshotRejectsCorruption) {
+    std::string const snapshot_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_SnapshotRejectsCorruption.bin").string();
+
+    auto launcher = createGpuProcessorLauncher(2u, 256u);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    launcher->save_snapshot(snapshot_path.c_str());
+
+    // flip a byte of the gain value
+    {
+        std::fstream file(snapshot_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last {};
+        file.read(&last, 1);
+        file.seekp(-1, std::ios::end);
+        last = static_cast<char>(last ^ 0x5A);
+        file.write(&last, 1);
+    }
+    EXPECT_THROW(createGpuProcessorLauncherFromSnapshot(snapshot_path.c_str()), std::runtime_error);
+
+    // a consistent snapshot of a specification without its magic
+    auto unchecked = createGpuProcessorLauncher(2u, 256u);
+    GainConfig::Specification no_magic_spec {.ThisMagic = 0u, .params {.gain_value = 2.f}};
+    unchecked->load_processor(L"gain", &no_magic_spec, sizeof(no_magic_spec));
+    unchecked->save_snapshot(snapshot_path.c_str());
+    EXPECT_THROW(createGpuProcessorLauncherFromSnapshot(snapshot_path.c_str()), std::runtime_error);
+
+    std::filesystem::remove(snapshot_path);
+}
+
+TEST(ProcLaunchLib, CaptureReplaysInput) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint32_t nblocks {3u};
+    std::string const capture_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_CaptureReplaysInput.bin").string();
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    // the settings are captured as well
+    launcher->set_silence_skipping(true, 0.f);
+    launcher->set_deadline({.policy = DeadlinePolicy::ePassThrough, .deadline_us = 1000000u});
+    launcher->set_inactive_channel_output(InactiveChannelOutput::eUntouched);
+
+    // an active block, a block with the second channel inactive and a silent block
+    uint8_t const masks[nblocks][nchannels] {{1u, 1u}, {1u, 0u}, {1u, 1u}};
+    std::vector<TestData> inputs, outputs;
+    launcher->start_capture(capture_path.c_str());
+    for (uint32_t b_id {0u}; b_id < nblocks; ++b_id) {
+        inputs.emplace_back(nchannels, nsamples, b_id + 1u < nblocks ? 1.f : 0.f, TestData::DataMode::Random);
+        outputs.emplace_back(nchannels, nsamples, 1.f);
+        launcher->process(inputs.back()(), outputs.back()(), nsamples, masks[b_id]);
+    }
+    launcher->stop_capture();
+    // blocks after the capture was stopped are not recorded
+    launcher->process(inputs.back()(), outputs.back()(), nsamples);
+    uint64_t const skipped_launches = launcher->get_statistics().skipped_launches;
+
+    auto capture = openCapture(capture_path.c_str());
+    ASSERT_NE(capture, nullptr);
+    EXPECT_EQ(capture->get_nchannels_in(), nchannels);
+    EXPECT_EQ(capture->get_nchannels_out(), nchannels);
+
+    auto replay = capture->create_launcher();
+    CapturedBlock block;
+    uint64_t last_timestamp {0u};
+    for (uint32_t b_id {0u}; b_id < nblocks; ++b_id) {
+        ASSERT_TRUE(capture->next_block(block));
+        ASSERT_EQ(block.nsamples, nsamples);
+        EXPECT_GE(block.timestamp_ns, last_timestamp);
+        last_timestamp = block.timestamp_ns;
+        EXPECT_EQ(block.active_channels != nullptr, b_id == 1u);
+
+        TestData output(nchannels, nsamples, 1.f);
+        replay->process(block.channels.data(), output(), static_cast<int>(block.nsamples), block.active_channels);
+        EXPECT_TRUE(CompareBuffers(outputs[b_id], 0u, output, 0u));
+    }
+    EXPECT_FALSE(capture->next_block(block));
+    replay->process(block.channels.data(), outputs.back()(), nsamples);
+    EXPECT_EQ(replay->get_statistics().skipped_launches, skipped_launches);
+    EXPECT_GT(skipped_launches, 0u);
+    EXPECT_GT(replay->get_memory_footprint().deadline_buffers, 0u);
+
+    capture->rewind();
+    EXPECT_TRUE(capture->next_block(block));
+
+    std::filesystem::remove(capture_path);
+}
+
+TEST(ProcLaunchLib, CaptureStopsWhenWriterFallsBehind) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    std::string const capture_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_CaptureStopsWhenWriterFallsBehind.bin").string();
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    // a block larger than the recorder's ring can never be queued; process() still succeeds
+    constexpr uint32_t large_nsamples {nsamples * 128u};
+    TestData input(nchannels, large_nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, large_nsamples, 0.f);
+    launcher->start_capture(capture_path.c_str());
+    EXPECT_NO_THROW(launcher->process(input(), output(), large_nsamples));
+    apply_gain(input, 2.f);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+    EXPECT_THROW(launcher->stop_capture(), std::runtime_error);
+
+    // the capture holds the blocks before it stopped
+    auto capture = openCapture(capture_path.c_str());
+    CapturedBlock block;
+    EXPECT_FALSE(capture->next_block(block));
+
+    std::filesystem::remove(capture_path);
+}
+
+TEST(ProcLaunchLib, WarmUpLeavesNoTrace) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    EXPECT_GE(launcher->warm_up(8u), 0.0);
+    EXPECT_EQ(launcher->get_statistics().launches, 0u);
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+    launcher->process(input(), output(), nsamples);
+    EXPECT_EQ(launcher->get_statistics().launches, 1u);
+
+    apply_gain(input, 2.f);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+}
+
+TEST(ProcLaunchLib, WarmUpStartsFromFreshProcessors) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+
+    FirConfig::Specification fir_spec {.filter_length = 300u, .filter_index = 0u};
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    launcher->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+    auto fresh = createGpuProcessorLauncher(nchannels, nsamples);
+    fresh->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+
+    // leave the filter's memory filled before warming up
+    TestData loud(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+    launcher->process(loud(), output(), nsamples);
+    launcher->warm_up(4u);
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Sin);
+    TestData expected(nchannels, nsamples, 0.f);
+    launcher->process(input(), output(), nsamples);
+    fresh->process(input(), expected(), nsamples);
+    EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+}
+
+TEST(ProcLaunchLib, RenderSegmentedMatchesSerialRender) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint32_t ntotal {3001u};
+
+    // the filter's memory spans launches and segment boundaries; its derived tail covers all of it
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    FirConfig::Specification fir_spec {.filter_length = 300u, .filter_index = 0u};
+    launcher->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+    GainConfig::Specification gain_spec {.params {.gain_value = 0.5f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    TestData input(nchannels, ntotal, 1.f, TestData::DataMode::Random);
+    TestData serial(nchannels, ntotal, 0.f);
+    launcher->process(input(), serial(), ntotal);
+    uint64_t const serial_launches = launcher->get_statistics().launches;
+
+    // in place; every segment boundary lies within the input another segment pre-rolls over
+    TestData segmented {input};
+    launcher->render_segmented(segmented(), segmented(), ntotal, 4u);
+    EXPECT_TRUE(CompareBuffers(serial, 0u, segmented, 0u, 1e-5f));
+    EXPECT_GT(launcher->get_statistics().launches, 2u * serial_launches);
+}
+
+TEST(ProcLaunchLib, MemoryBudgetFailsArm) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    MemoryFootprint const footprint = launcher->get_memory_footprint();
+    EXPECT_EQ(footprint.processor_specs, sizeof(gain_spec));
+    EXPECT_GE(footprint.executor_buffers, 2u * nchannels * nsamples * sizeof(float));
+    EXPECT_EQ(footprint.deadline_buffers, 0u);
+
+    launcher->set_memory_budget(footprint.total() - 1u);
+    EXPECT_THROW(launcher->arm(), std::runtime_error);
+
+    launcher->set_memory_budget(footprint.total());
+    EXPECT_NO_THROW(launcher->arm());
+}
+
+TEST(ProcLaunchLib, ChannelActivityMask) {
+    constexpr uint32_t nchannels {4u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint8_t active_channels[nchannels] {1u, 0u, 1u, 0u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 7.f);
+    launcher->set_inactive_channel_output(InactiveChannelOutput::eUntouched);
+    launcher->arm();
+    uint64_t const scratch = launcher->get_memory_footprint().scratch;
+    launcher->process(input(), output(), nsamples, active_channels);
+    // the silent and the discarded channel buffers count as scratch
+    EXPECT_GE(launcher->get_memory_footprint().scratch, scratch + 2u * nsamples * sizeof(float));
+
+    TestData expected {input};
+    apply_gain(expected, 2.f);
+    for (uint32_t ch : {1u, 3u}) {
+        std::fill_n(expected.getChannel(ch), nsamples, 7.f);
+    }
+    EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+
+    launcher->set_inactive_channel_output(InactiveChannelOutput::eZero);
+    launcher->process(input(), output(), nsamples, active_channels);
+    for (uint32_t ch : {1u, 3u}) {
+        std::fill_n(expected.getChannel(ch), nsamples, 0.f);
+    }
+    EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+
+    // without active channels, the launch is skipped
+    constexpr uint8_t no_channels[nchannels] {};
+    launcher->process(input(), output(), nsamples, no_channels);
+    EXPECT_EQ(launcher->get_statistics().launches, 2u);
+    EXPECT_EQ(launcher->get_statistics().skipped_launches, 1u);
+}
+
+TEST(ProcLaunchLib, InactiveChannelState) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint8_t all_channels[nchannels] {1u, 1u};
+    constexpr uint8_t no_channels[nchannels] {};
+
+    FirConfig::Specification fir_spec {.filter_length = 300u, .filter_index = 0u};
+    TestData first(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData second(nchannels, nsamples, 1.f, TestData::DataMode::Sin);
+    TestData output(nchannels, nsamples, 0.f);
+
+    for (InactiveChannelState const policy : {InactiveChannelState::eFrozen, InactiveChannelState::eReset}) {
+        auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+        launcher->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+        launcher->set_inactive_channel_state(policy);
+        launcher->process(first(), output(), nsamples, all_channels);
+        launcher->process(first(), output(), nsamples, no_channels);
+        launcher->process(second(), output(), nsamples, all_channels);
+
+        // frozen, the filter continues as if the inactive block didn't exist; reset, it starts over
+        auto reference = createGpuProcessorLauncher(nchannels, nsamples);
+        reference->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+        TestData expected(nchannels, nsamples, 0.f);
+        if (policy == InactiveChannelState::eFrozen) {
+            reference->process(first(), expected(), nsamples);
+        }
+        reference->process(second(), expected(), nsamples);
+        EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+    }
+}
+
+TEST(ProcLaunchLib, SilenceSkippingWaitsForTail) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+
+    // the tail of the filter is derived from its length; no tail is declared
+    FirConfig::Specification fir_spec {.filter_length = 300u, .filter_index = 0u};
+    auto skipping = createGpuProcessorLauncher(nchannels, nsamples);
+    skipping->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+    skipping->set_silence_skipping(true, 0.f);
+    auto reference = createGpuProcessorLauncher(nchannels, nsamples);
+    reference->load_processor(L"fir", &fir_spec, sizeof(fir_spec));
+
+    TestData loud(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData silence(nchannels, nsamples, 0.f);
+    TestData output(nchannels, nsamples, 1.f);
+    TestData expected(nchannels, nsamples, 1.f);
+
+    skipping->process(loud(), output(), nsamples);
+    reference->process(loud(), expected(), nsamples);
+    ASSERT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+    // the filter rings out over the first two silent blocks; those are processed, the rest are skipped
+    for (uint32_t b_id {0u}; b_id < 4u; ++b_id) {
+        skipping->process(silence(), output(), nsamples);
+        reference->process(silence(), expected(), nsamples);
+        EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+        if (b_id == 0u) {
+            EXPECT_FALSE(CompareBuffers(silence, 0u, output, 0u));
+        }
+    }
+
+    LauncherStatistics const stats = skipping->get_statistics();
+    EXPECT_EQ(stats.launches, 3u);
+    EXPECT_EQ(stats.skipped_launches, 2u);
+}
+
+TEST(ProcLaunchLib, OfflineProcessesLongSpans) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {48000u + 17u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, 0u, ProcessingMode::eOffline);
+    GainConfig::Specification gain_spec {.params {.gain_value = 0.25f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Sin);
+    TestData output(nchannels, nsamples, 0.f);
+    launcher->process(input(), output(), nsamples);
+
+    apply_gain(input, 0.25f);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+    // offline launches are at least 4096 samples per channel
+    EXPECT_LE(launcher->get_statistics().launches, (nsamples + 4095u) / 4096u);
+}
+
+TEST(ProcLaunchLib, DeadlineMetProducesProcessedOutput) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 0.5f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    launcher->set_deadline({.policy = DeadlinePolicy::ePassThrough, .deadline_us = 1000000u});
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 0.f);
+    for (uint32_t b_id {0u}; b_id < 4u; ++b_id) {
+        launcher->process(input(), output(), nsamples);
+    }
+    launcher->clear_deadline();
+
+    apply_gain(input, 0.5f);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+    EXPECT_EQ(launcher->get_statistics().deadline_misses, 0u);
+}
+
+TEST(ProcLaunchLib, DeadlineMissesAreCounted) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint32_t nblocks {16u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 0.5f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    // few launches finish within a microsecond
+    launcher->set_deadline({.policy = DeadlinePolicy::eSilence, .deadline_us = 1u});
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData silence(nchannels, nsamples, 0.f);
+    uint64_t nsilent {0u};
+    for (uint32_t b_id {0u}; b_id < nblocks; ++b_id) {
+        TestData output(nchannels, nsamples, 1.f);
+        launcher->process(input(), output(), nsamples);
+        nsilent += CompareBuffers(silence, 0u, output, 0u, 0.f) ? 1u : 0u;
+    }
+    launcher->clear_deadline();
+
+    // exactly the missed blocks are answered with silence
+    EXPECT_EQ(launcher->get_statistics().deadline_misses, nsilent);
+}
+
+TEST(ProcLaunchLib, DerivedDeadlineNeedsSampleRate) {
+    auto launcher = createGpuProcessorLauncher(2u, 256u);
+    EXPECT_THROW(launcher->set_deadline({.sample_rate = 0.f}), std::runtime_error);
+    // an explicit deadline doesn't use the sample rate
+    EXPECT_NO_THROW(launcher->set_deadline({.deadline_us = 1000u, .sample_rate = 0.f}));
+}
+
+TEST(ProcLaunchLib, RoutingMatrixMonoToStereo) {
+    constexpr uint32_t nsamples {256u};
+    std::string const snapshot_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_RoutingMatrixMonoToStereo.bin").string();
+
+    // left gets the full chain output, right half of it
+    float const routing_matrix[2] {1.f, 0.5f};
+    auto launcher = createGpuProcessorLauncher(1u, 2u, nsamples, routing_matrix);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    launcher->save_snapshot(snapshot_path.c_str());
+    auto restored = createGpuProcessorLauncherFromSnapshot(snapshot_path.c_str());
+    std::filesystem::remove(snapshot_path);
+
+    TestData input(1u, 2u * nsamples, 1.f, TestData::DataMode::Random);
+    TestData expected(2u, 2u * nsamples, 0.f);
+    for (uint32_t s {0u}; s < 2u * nsamples; ++s) {
+        expected.at(0u, s) = 2.f * input.at(0u, s);
+        expected.at(1u, s) = input.at(0u, s);
+    }
+
+    for (auto* proc_launcher : {launcher.get(), restored.get()}) {
+        TestData output(2u, 2u * nsamples, 1.f);
+        proc_launcher->process(input(), output(), 2u * nsamples);
+        EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+    }
+}
+
+TEST(ProcLaunchLib, InPlaceAcrossMultipleLaunches) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint32_t ntotal {3u * nsamples + 5u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+    GainConfig::Specification gain_spec {.params {.gain_value = 3.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+    TestData input(nchannels, ntotal, 1.f, TestData::DataMode::Random);
+    TestData expected {input};
+    apply_gain(expected, 3.f);
+
+    // once with synchronous launches, once with launches on the deadline thread
+    TestData data {input};
+    launcher->process(data(), data(), ntotal);
+    EXPECT_TRUE(CompareBuffers(expected, 0u, data, 0u, 1e-5f));
+
+    launcher->set_deadline({.policy = DeadlinePolicy::ePassThrough, .deadline_us = 1000000u});
+    data = input;
+    launcher->process(data(), data(), ntotal);
+    EXPECT_TRUE(CompareBuffers(expected, 0u, data, 0u, 1e-5f));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "FirSpecification.h"
+#include "GainSpecification.h"
+#include "TestCommon.h"
+
+#include <GPUCreate.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(ProcessorLauncherFarm, CreateDestroy) {
+    std::unique_ptr<ProcessorLauncherFarmInterface> farm = createProcessorLauncherFarm(2u);
+    ASSERT_NE(farm, nullptr);
+    EXPECT_EQ(farm->get_worker_count(), 2u);
+}
+
+TEST(ProcessorLauncherFarm, StreamsKeepOrderAndState) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    constexpr uint32_t nstreams {6u};
+    constexpr uint32_t nblocks {8u};
+
+    auto farm = createProcessorLauncherFarm(2u);
+
+    // an FIR longer than a block carries state from block to block; processing the blocks of a stream
+    // out of order or on another stream's launcher changes the output
+    auto create_launcher = [](uint32_t s_id) {
+        auto launcher = createGpuProcessorLauncher(nchannels, nsamples);
+        FirConfig::Specification fir_spec {.filter_length = 300u, .filter_index = 0u};
+        launcher->load_processor(L"fir", &fir_spec, sizeof(fir_spec), fir_spec.filter_length);
+        GainConfig::Specification gain_spec {.params {.gain_value = 0.5f + static_cast<float>(s_id)}};
+        launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+        return launcher;
+    };
+
+    std::vector<uint32_t> stream_ids;
+    std::vector<TestData> inputs, outputs;
+    for (uint32_t s_id {0u}; s_id < nstreams; ++s_id) {
+        stream_ids.push_back(farm->add_stream(create_launcher(s_id), nchannels, nchannels));
+        inputs.emplace_back(nchannels, nsamples * nblocks, 1.f, TestData::DataMode::Random);
+        outputs.emplace_back(nchannels, nsamples * nblocks, 0.f);
+    }
+
+    // interleave the submissions of all streams
+    std::vector<float const*> in_ptr(nchannels);
+    std::vector<float*> out_ptr(nchannels);
+    for (uint32_t b_id {0u}; b_id < nblocks; ++b_id) {
+        for (uint32_t s_id {0u}; s_id < nstreams; ++s_id) {
+            for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+                in_ptr[ch] = inputs[s_id].getChannel(ch) + b_id * nsamples;
+                out_ptr[ch] = outputs[s_id].getChannel(ch) + b_id * nsamples;
+            }
+            farm->submit(stream_ids[s_id], in_ptr.data(), out_ptr.data(), nsamples);
+        }
+    }
+    farm->wait_all();
+
+    // compare with rendering each stream serially on its own launcher
+    for (uint32_t s_id {0u}; s_id < nstreams; ++s_id) {
+        TestData expected(nchannels, nsamples * nblocks, 0.f);
+        create_launcher(s_id)->process(inputs[s_id](), expected(), static_cast<int>(nsamples * nblocks));
+        EXPECT_TRUE(CompareBuffers(expected, 0u, outputs[s_id], 0u, 1e-5f));
+        farm->remove_stream(stream_ids[s_id]);
+    }
+}
+
+TEST(ProcessorLauncherFarm, RemovedStreamRejectsCalls) {
+    auto farm = createProcessorLauncherFarm(2u);
+    uint32_t const stream_id = farm->add_stream(createGpuProcessorLauncher(2u, 256u), 2u, 2u);
+    farm->remove_stream(stream_id);
+    EXPECT_THROW(farm->wait(stream_id), std::runtime_error);
+    EXPECT_THROW(farm->remove_stream(stream_id), std::runtime_error);
+}
+
+TEST(ProcessorLauncherFarm, WorkersReportThreadConfig) {
+    setProcessingThreadConfig({.flush_denormals = true});
+    auto farm = createProcessorLauncherFarm(2u);
+
+    // the workers apply the configuration once they run
+    std::vector<ThreadReport> reports;
+    for (uint32_t attempt {0u}; attempt < 100u && reports.size() < 2u; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reports = getProcessingThreadReports();
+    }
+    ASSERT_EQ(reports.size(), 2u);
+    for (ThreadReport const& report : reports) {
+        EXPECT_EQ(report.name.rfind("gpua-farm-", 0u), 0u);
+        // nothing but the denormal mode was requested
+        EXPECT_FALSE(report.affinity_applied);
+        EXPECT_FALSE(report.scheduling_applied);
+    }
+
+    farm.reset();
+    EXPECT_TRUE(getProcessingThreadReports().empty());
+    setProcessingThreadConfig({});
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include "GainSpecification.h"
+#include "TestCommon.h"
+
+#include <SharedMemoryProtocol.h>
+
+#include <GPUCreate.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+TEST(SharedMemoryServer, ClientProcessesOnServer) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    std::string const socket_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_ClientProcessesOnServer.sock").string();
+
+    auto server = createProcessingServer(socket_path.c_str());
+    std::thread server_thread([&server] { server->run(); });
+
+    {
+        auto client = createSharedMemoryLauncher(socket_path.c_str(), nchannels, nchannels, nsamples);
+        GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+        client->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+        // larger than the stream's capacity and in place
+        TestData input(nchannels, 3u * nsamples, 1.f, TestData::DataMode::Random);
+        TestData output {input};
+        client->process(output(), output(), 3 * static_cast<int>(nsamples));
+        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+            for (uint32_t s {0u}; s < 3u * nsamples; ++s) {
+                input.at(ch, s) *= 2.f;
+            }
+        }
+        EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+        EXPECT_EQ(client->get_statistics().launches, 3u);
+        // a block without active channels isn't sent; the next one recreates the processors on the server first
+        constexpr uint8_t no_channels[nchannels] {};
+        client->set_inactive_channel_state(InactiveChannelState::eReset);
+        client->process(output(), output(), static_cast<int>(nsamples), no_channels);
+        client->process(output(), output(), static_cast<int>(nsamples));
+        EXPECT_EQ(client->get_statistics().launches, 4u);
+        // only the server's user may connect
+        EXPECT_EQ(std::filesystem::status(socket_path).permissions() & std::filesystem::perms::all,
+            std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+        // the server has no capture directory
+        EXPECT_THROW(client->start_capture("capture.bin"), std::runtime_error);
+
+        // the server's errors are rethrown by the client
+        auto broken = createSharedMemoryLauncher(socket_path.c_str(), nchannels, nchannels, nsamples);
+        broken->load_processor(L"no_such_processor", &gain_spec, sizeof(gain_spec));
+        EXPECT_THROW(broken->arm(), std::runtime_error);
+    }
+
+    server->stop();
+    server_thread.join();
+}
+
+TEST(SharedMemoryServer, AcquireCommitProcessesSharedMemory) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    std::string const socket_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_AcquireCommitProcessesSharedMemory.sock").string();
+
+    auto server = createProcessingServer(socket_path.c_str());
+    std::thread server_thread([&server] { server->run(); });
+
+    {
+        auto client = createSharedMemoryLauncher(socket_path.c_str(), nchannels, nchannels, nsamples);
+        GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+        client->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+        TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+        float* const* staged = client->acquire_input(nsamples);
+        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+            std::copy_n(input.getChannel(ch), nsamples, staged[ch]);
+        }
+        float const* const* result = client->commit(nsamples);
+
+        TestData output(nchannels, nsamples, 0.f);
+        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+            std::copy_n(result[ch], nsamples, output.getChannel(ch));
+            for (uint32_t s {0u}; s < nsamples; ++s) {
+                input.at(ch, s) *= 2.f;
+            }
+        }
+        EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u, 1e-5f));
+
+        // nothing acquired, and the shared memory doesn't grow beyond the stream's capacity
+        EXPECT_THROW(client->commit(nsamples), std::runtime_error);
+        EXPECT_THROW(client->acquire_input(nsamples + 1u), std::runtime_error);
+    }
+
+    server->stop();
+    server_thread.join();
+}
+
+TEST(SharedMemoryServer, CapturesStayInCaptureDirectory) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t nsamples {256u};
+    std::string const socket_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_CapturesStayInCaptureDirectory.sock").string();
+    std::filesystem::path const capture_directory = std::filesystem::temp_directory_path() / "ProcLaunchLib_CapturesStayInCaptureDirectory";
+    std::filesystem::create_directories(capture_directory);
+
+    auto server = createProcessingServer(socket_path.c_str(), capture_directory.string().c_str());
+    std::thread server_thread([&server] { server->run(); });
+
+    {
+        auto client = createSharedMemoryLauncher(socket_path.c_str(), nchannels, nchannels, nsamples);
+        GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+        client->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+
+        EXPECT_THROW(client->start_capture("../escaped.bin"), std::runtime_error);
+        EXPECT_THROW(client->start_capture(capture_directory.string().c_str()), std::runtime_error);
+
+        TestData data(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+        client->start_capture("capture.bin");
+        client->process(data(), data(), nsamples);
+        client->stop_capture();
+        auto capture = openCapture((capture_directory / "capture.bin").string().c_str());
+        CapturedBlock block;
+        EXPECT_TRUE(capture->next_block(block));
+    }
+
+    server->stop();
+    server_thread.join();
+    std::filesystem::remove_all(capture_directory);
+}
+
+TEST(SharedMemoryServer, OversizedMessageDropsClient) {
+    std::string const socket_path = (std::filesystem::temp_directory_path() / "ProcLaunchLib_OversizedMessageDropsClient.sock").string();
+
+    auto server = createProcessingServer(socket_path.c_str());
+    std::thread server_thread([&server] { server->run(); });
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1u);
+    int const client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr const*>(&address), sizeof(address)), 0);
+
+    // announce a payload beyond the protocol's maximum; the server closes the connection instead of allocating it
+    uint32_t const header[] {static_cast<uint32_t>(SharedMemoryProtocol::Op::eGetStatistics), SharedMemoryProtocol::MaxPayloadSize + 1u};
+    ASSERT_EQ(::send(client, header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+    uint32_t tag {0u};
+    std::vector<std::byte> payload;
+    EXPECT_FALSE(SharedMemoryProtocol::receive_message(client, tag, payload));
+    ::close(client);
+
+    server->stop();
+    server_thread.join();
+}
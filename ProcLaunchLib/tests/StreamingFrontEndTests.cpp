@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "GainSpecification.h"
+#include "TestCommon.h"
+
+#include <GPUCreate.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+// launcher that blocks in process() until released; copies the input to the output
+class StalledLauncher : public ProcessorLauncherInterface {
+public:
+    explicit StalledLauncher(std::atomic<bool>& released) :
+        m_released {released} {}
+
+    void process(float const* const* input, float* const* output, const int nsamples) override {
+        m_released.wait(false);
+        for (uint32_t ch {0u}; ch < 2u; ++ch) {
+            std::copy_n(input[ch], nsamples, output[ch]);
+        }
+    }
+    void process(float const* const* input, float* const* output, const int nsamples, uint8_t const*) override {
+        process(input, output, nsamples);
+    }
+    void set_inactive_channel_output(InactiveChannelOutput) override {}
+    void set_inactive_channel_state(InactiveChannelState) override {}
+    void render_segmented(float const* const*, float* const*, uint32_t, uint32_t) override {}
+    void arm() override {}
+    void disarm() override {}
+    double warm_up(uint32_t) override {
+        return 0.;
+    }
+    void load_processor(wchar_t const*, void const*, uint32_t, uint32_t) override {}
+    void save_snapshot(char const*) override {}
+    void start_capture(char const*) override {}
+    void stop_capture() override {}
+    void set_silence_skipping(bool, float) override {}
+    void set_deadline(DeadlineConfig const&) override {}
+    void clear_deadline() override {}
+    LauncherStatistics get_statistics() const override {
+        return {};
+    }
+    MemoryFootprint get_memory_footprint() const override {
+        return {};
+    }
+    void set_memory_budget(uint64_t) override {}
+
+private:
+    std::atomic<bool>& m_released;
+};
+
+// releases a StalledLauncher, also if an assertion returns early
+struct Release {
+    std::atomic<bool>& released;
+
+    void operator()() const {
+        released = true;
+        released.notify_all();
+    }
+    ~Release() {
+        (*this)();
+    }
+};
+} // namespace
+
+TEST(StreamingFrontEnd, OutputIsDelayedBySafetyMargin) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t block_size {256u};
+    constexpr uint32_t safety_margin {512u};
+    constexpr uint32_t callback_size {128u};
+    constexpr uint32_t nsamples {callback_size * 64u};
+
+    auto launcher = createGpuProcessorLauncher(nchannels, block_size);
+    GainConfig::Specification gain_spec {.params {.gain_value = 2.f}};
+    launcher->load_processor(L"gain", &gain_spec, sizeof(gain_spec));
+    auto front_end = createStreamingFrontEnd(std::move(launcher), nchannels, nchannels, block_size, safety_margin);
+
+    TestData input(nchannels, nsamples, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, nsamples, 1.f);
+
+    std::vector<float const*> in_ptr(nchannels);
+    std::vector<float*> out_ptr(nchannels);
+    for (uint32_t cursor {0u}; cursor < nsamples; cursor += callback_size) {
+        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+            in_ptr[ch] = input.getChannel(ch) + cursor;
+            out_ptr[ch] = output.getChannel(ch) + cursor;
+        }
+        ASSERT_EQ(front_end->push_input(in_ptr.data(), callback_size), callback_size);
+        // emulate a callback that always finds enough output
+        while (front_end->get_statistics().output_fill < callback_size) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        ASSERT_EQ(front_end->pull_output(out_ptr.data(), callback_size), callback_size);
+    }
+
+    StreamingStatistics const stats = front_end->get_statistics();
+    EXPECT_EQ(stats.underruns, 0u);
+    EXPECT_EQ(stats.overruns, 0u);
+
+    // the margin is primed with silence; the processed input follows
+    TestData expected(nchannels, nsamples, 0.f);
+    for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+        for (uint32_t s {safety_margin}; s < nsamples; ++s) {
+            expected.at(ch, s) = 2.f * input.at(ch, s - safety_margin);
+        }
+    }
+    EXPECT_TRUE(CompareBuffers(expected, 0u, output, 0u, 1e-5f));
+}
+
+TEST(StreamingFrontEnd, StalledLauncherCausesUnderrun) {
+    constexpr uint32_t nchannels {2u};
+    constexpr uint32_t block_size {256u};
+
+    std::atomic<bool> released {false};
+    auto front_end = createStreamingFrontEnd(std::make_unique<StalledLauncher>(released), nchannels, nchannels, block_size, block_size);
+    Release release {released};
+
+    TestData input(nchannels, block_size, 1.f, TestData::DataMode::Random);
+    TestData output(nchannels, block_size, 1.f);
+    TestData silence(nchannels, block_size, 0.f);
+
+    ASSERT_EQ(front_end->push_input(input(), block_size), block_size);
+    // the margin covers the first pull
+    ASSERT_EQ(front_end->pull_output(output(), block_size), block_size);
+    EXPECT_EQ(front_end->get_statistics().underruns, 0u);
+
+    // the launcher is still stuck on the pushed block; the next pull finds no output and is filled with silence
+    EXPECT_EQ(front_end->pull_output(output(), block_size), 0u);
+    EXPECT_EQ(front_end->get_statistics().underruns, 1u);
+    EXPECT_TRUE(CompareBuffers(silence, 0u, output, 0u));
+
+    release();
+    while (front_end->get_statistics().output_fill < block_size) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    ASSERT_EQ(front_end->pull_output(output(), block_size), block_size);
+    EXPECT_TRUE(CompareBuffers(input, 0u, output, 0u));
+    EXPECT_EQ(front_end->get_statistics().underruns, 1u);
+}
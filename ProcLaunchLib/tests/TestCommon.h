@@ -237,7 +237,7 @@ struct TestData {
     }
 };
 
-bool CompareBuffers(TestData const& lhs, uint32_t lhs_off, TestData const& rhs, uint32_t rhs_off, float const tol = 1e-6f) {
+inline bool CompareBuffers(TestData const& lhs, uint32_t lhs_off, TestData const& rhs, uint32_t rhs_off, float const tol = 1e-6f) {
     if (lhs.m_nchannels != rhs.m_nchannels || lhs.m_nsamples != rhs.m_nsamples)
         return false;
 
@@ -1,6 +1,7 @@
 #include <AudioFile/AudioFile.h>
 #include <GPUCreate.h>
 
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -38,17 +39,16 @@ int main(int argc, char** argv) {
     std::string outputfile = std::filesystem::path(infilepath).filename().replace_extension().string() + "_iir" + params_str + ".wav";
     std::string outfilepath = (std::filesystem::path(infilepath).parent_path() / outputfile).string();
 
-    // load input wav
-    AudioFile<float> input;
-    if (!input.load(infilepath)) {
+    // load input wav; it is rendered in place and saved as the output
+    AudioFile<float> audio;
+    if (!audio.load(infilepath)) {
         printf("Could not open input from %s\n", infilepath.c_str());
         return 1;
     }
-    uint32_t nchannels = input.getNumChannels();
+    uint32_t nchannels = audio.getNumChannels();
 
-    // create processor launcher with buffer_size samples per process buffer
-    constexpr uint32_t buffer_size {512u};
-    auto proc_launcher = createGpuProcessorLauncher(nchannels, buffer_size);
+    // create an offline processor launcher; it sizes its process buffer for throughput
+    auto proc_launcher = createGpuProcessorLauncher(nchannels, 0u, ProcessingMode::eOffline);
     if (proc_launcher == nullptr) {
         printf("Could not create processor launcher\n");
         return 2;
@@ -60,29 +60,30 @@ int main(int argc, char** argv) {
             .sample_rate = params[3u * i + 0u],
             .band_pass_freq = params[3u * i + 1u],
             .band_pass_q = params[3u * i + 2u]};
+        // the launcher derives the ring-out of the filter from its specification
         proc_launcher->load_processor(L"iir", &iir_spec, sizeof(iir_spec));
     }
 
-    AudioFile<float> output {input};
-    uint32_t const nsamples_total = input.getNumSamplesPerChannel();
-    std::vector<float*> in_ptr(nchannels, nullptr), out_ptr(nchannels, nullptr);
-
-    // call process with `buffer_size`-sized chunks of the input (causing one internal process call at a time)
-    for (uint32_t cursor {0u}; cursor < nsamples_total; cursor += buffer_size) {
-        for (uint32_t ch {0u}; ch < nchannels; ++ch) {
-            in_ptr[ch] = input.samples[ch].data() + cursor;
-            out_ptr[ch] = output.samples[ch].data() + cursor;
-        }
-        uint32_t nsamples = std::min<uint32_t>(buffer_size, nsamples_total - cursor);
-        proc_launcher->process(in_ptr.data(), out_ptr.data(), nsamples);
+    // skip launches on digital silence once the filters rang out
+    proc_launcher->set_silence_skipping(true, 0.f);
+
+    uint32_t const nsamples_total = audio.getNumSamplesPerChannel();
+    std::vector<float*> audio_ptr(nchannels, nullptr);
+    for (uint32_t ch {0u}; ch < nchannels; ++ch) {
+        audio_ptr[ch] = audio.samples[ch].data();
     }
 
+    // render the whole file in place; segments of the file are rendered in parallel, each pre-rolled by the chain's tail
+    proc_launcher->render_segmented(audio_ptr.data(), audio_ptr.data(), nsamples_total);
+
     // write the output
-    if (!output.save(outfilepath)) {
+    if (!audio.save(outfilepath)) {
         printf("Could not save output to %s\n", outfilepath.c_str());
         return 3;
     }
 
+    LauncherStatistics const stats = proc_launcher->get_statistics();
+    printf("Skipped %llu of %llu launches on silent input\n", static_cast<unsigned long long>(stats.skipped_launches), static_cast<unsigned long long>(stats.launches + stats.skipped_launches));
     printf("IIR processing was successful\n");
 
     return 0;
@@ -0,0 +1,63 @@
+#ifndef CAPTURE_READER_INTERFACE_H
+#define CAPTURE_READER_INTERFACE_H
+
+#include "ProcessorLauncherInterface.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * An input block of a capture
+ */
+struct CapturedBlock {
+    // time of the process() call relative to the start of the capture
+    uint64_t timestamp_ns {0u};
+    uint32_t nsamples {0u};
+    // pointers to the channels of the input audio data; valid as long as the reader exists
+    std::vector<float const*> channels;
+    // channel activity mask of the process() call, one entry per input channel; nullptr if all channels were active
+    uint8_t const* active_channels {nullptr};
+};
+
+/**
+ * Public interface to read a capture written by ProcessorLauncherInterface::start_capture
+ */
+class CaptureReaderInterface {
+public:
+    /**
+     * @brief Default destructor
+     */
+    virtual ~CaptureReaderInterface() = default;
+
+    /**
+     * @brief Get the number of input channels of the captured launcher
+     */
+    virtual uint32_t get_nchannels_in() const = 0;
+
+    /**
+     * @brief Get the number of output channels of the captured launcher
+     */
+    virtual uint32_t get_nchannels_out() const = 0;
+
+    /**
+     * @brief Create and arm a fresh launcher with the captured configuration, processors, silence skipping, deadline,
+     * inactive channel output and inactive channel state
+     * @return ProcessorLauncherInterface pointer to the created launcher
+     */
+    virtual std::unique_ptr<ProcessorLauncherInterface> create_launcher() const = 0;
+
+    /**
+     * @brief Read the next input block of the capture
+     * @param block [out] the block
+     * @return false if there are no more blocks
+     */
+    virtual bool next_block(CapturedBlock& block) = 0;
+
+    /**
+     * @brief Continue reading at the first block of the capture
+     */
+    virtual void rewind() = 0;
+};
+
+#endif // CAPTURE_READER_INTERFACE_H
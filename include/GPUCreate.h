@@ -1,6 +1,12 @@
 #pragma once
 
+#include "CaptureReaderInterface.h"
+#include "ProcessingServerInterface.h"
+#include "ProcessorLauncherFarmInterface.h"
 #include "ProcessorLauncherInterface.h"
+#include "SharedMemoryLauncherInterface.h"
+#include "StreamingFrontEndInterface.h"
+#include "ThreadConfig.h"
 
 #include <cstdint>
 #include <memory>
@@ -8,7 +14,99 @@
 /**
  * @brief Create an instance of the GPUProcessorLauncher.
  * @param nchannels [in] number of channels of the audio data to process
- * @param nsamples_per_channel [in] capacity of the processing-buffer per channel
+ * @param nsamples_per_channel [in] capacity of the processing-buffer per channel; the minimum capacity in offline mode
+ * @param mode [in] real-time or offline processing
  * @return ProcessorLauncherInterface pointer to the created GPUProcessorLauncher instance
  */
-std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels = 2u, uint32_t nsamples_per_channel = 256u);
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels = 2u, uint32_t nsamples_per_channel = 256u, ProcessingMode mode = ProcessingMode::eRealtime);
+
+/**
+ * @brief Create an instance of the GPUProcessorLauncher with different input and output channel counts.
+ * Without a routing matrix, the chain itself maps nchannels_in to nchannels_out channels. With a routing matrix, the chain
+ * processes nchannels_in channels and the matrix mixes them into the output: out[o] = sum_i routing_matrix[o * nchannels_in + i] * chain[i].
+ * @param nchannels_in [in] number of channels of the input audio data
+ * @param nchannels_out [in] number of channels of the output audio data
+ * @param nsamples_per_channel [in] capacity of the processing-buffer per channel; the minimum capacity in offline mode
+ * @param routing_matrix [in] optional nchannels_out x nchannels_in row-major matrix; copied by the launcher
+ * @param mode [in] real-time or offline processing
+ * @return ProcessorLauncherInterface pointer to the created GPUProcessorLauncher instance
+ */
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncher(uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix = nullptr, ProcessingMode mode = ProcessingMode::eRealtime);
+
+/**
+ * @brief Create an instance of the GPUProcessorLauncher from a snapshot written by ProcessorLauncherInterface::save_snapshot.
+ * The processors of the snapshot are loaded and the launcher is armed.
+ * @param snapshot_path [in] path of the snapshot file to restore
+ * @return ProcessorLauncherInterface pointer to the restored GPUProcessorLauncher instance
+ */
+std::unique_ptr<ProcessorLauncherInterface> createGpuProcessorLauncherFromSnapshot(char const* snapshot_path);
+
+/**
+ * @brief Open a capture written by ProcessorLauncherInterface::start_capture for replay.
+ * @param capture_path [in] path of the capture file
+ * @return CaptureReaderInterface pointer to the created CaptureReader instance
+ */
+std::unique_ptr<CaptureReaderInterface> openCapture(char const* capture_path);
+
+/**
+ * @brief Create a farm that processes the blocks of many streams on a fixed pool of worker threads.
+ * @param nworkers [in] number of worker threads; 0 creates one worker per hardware thread
+ * @return ProcessorLauncherFarmInterface pointer to the created ProcessorLauncherFarm instance
+ */
+std::unique_ptr<ProcessorLauncherFarmInterface> createProcessorLauncherFarm(uint32_t nworkers = 0u);
+
+/**
+ * @brief Create a streaming front-end that decouples an audio callback from the launches of a launcher.
+ * @param launcher [in] configured launcher that processes the stream; the front-end takes ownership
+ * @param nchannels_in [in] number of channels of the input audio data
+ * @param nchannels_out [in] number of channels of the output audio data
+ * @param block_size [in] number of samples per channel the processing thread passes to the launcher at once
+ * @param safety_margin [in] latency in samples per channel the launches may take without causing an underrun
+ * @return StreamingFrontEndInterface pointer to the created StreamingFrontEnd instance
+ */
+std::unique_ptr<StreamingFrontEndInterface> createStreamingFrontEnd(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t block_size, uint32_t safety_margin);
+
+/**
+ * @brief Set the CPU affinity, scheduling and denormal settings of the processing threads the library starts from now on
+ * (farm workers, streaming front-end, deadline and segment rendering threads)
+ * @param config [in] settings to apply
+ */
+void setProcessingThreadConfig(ThreadConfig const& config);
+
+/**
+ * @brief Apply settings to the calling thread, e.g., the host's audio thread that calls process()
+ * @param config [in] settings to apply
+ * @param name [in] name of the thread
+ * @return the settings that were actually applied
+ */
+ThreadReport applyThreadConfig(ThreadConfig const& config, char const* name);
+
+/**
+ * @brief Get the settings that were actually applied to the running processing threads of the library
+ */
+std::vector<ThreadReport> getProcessingThreadReports();
+
+#ifdef __linux__
+/**
+ * @brief Create a local processing server that owns the launchers of other processes; see ProcessingServerInterface
+ * @param socket_path [in] path of the Unix socket the clients connect to; only processes of the server's user may connect
+ * @param capture_directory [in] directory the captures of the clients are written to; nullptr rejects captures
+ * @return ProcessingServerInterface pointer to the created server
+ */
+std::unique_ptr<ProcessingServerInterface> createProcessingServer(char const* socket_path, char const* capture_directory = nullptr);
+
+/**
+ * @brief Create a launcher that processes on a local processing server. Takes the same configuration as
+ * createGpuProcessorLauncher; the processors are created on the server when the launcher is armed. start_capture takes
+ * a file name, which the server creates in its capture directory. Blocks can also be exchanged through the shared memory
+ * directly; see SharedMemoryLauncherInterface.
+ * @param socket_path [in] path of the server's Unix socket
+ * @param nchannels_in [in] number of channels of the input audio data
+ * @param nchannels_out [in] number of channels of the output audio data
+ * @param nsamples_per_channel [in] maximum number of samples per channel in the processing-buffer
+ * @param routing_matrix [in] optional nchannels_out x nchannels_in row-major matrix; see createGpuProcessorLauncher
+ * @param mode [in] real-time or offline processing
+ * @return SharedMemoryLauncherInterface pointer to the created client
+ */
+std::unique_ptr<SharedMemoryLauncherInterface> createSharedMemoryLauncher(char const* socket_path, uint32_t nchannels_in, uint32_t nchannels_out, uint32_t nsamples_per_channel, float const* routing_matrix = nullptr, ProcessingMode mode = ProcessingMode::eRealtime);
+#endif
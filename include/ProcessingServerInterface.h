@@ -0,0 +1,28 @@
+#ifndef PROCESSING_SERVER_INTERFACE_H
+#define PROCESSING_SERVER_INTERFACE_H
+
+/**
+ * Public interface of a local processing server (Linux only). The server owns one engine context; launchers created
+ * with createSharedMemoryLauncher in other processes attach to it over a Unix socket and exchange audio through shared
+ * memory. Every attached launcher is backed by a launcher of its own on the server and processed on a processing thread
+ * of its own; blocks of different clients are not batched into common launches.
+ */
+class ProcessingServerInterface {
+public:
+    /**
+     * @brief Default destructor; disconnects all clients
+     */
+    virtual ~ProcessingServerInterface() = default;
+
+    /**
+     * @brief Accept and serve clients until stop() is called; failures to accept a client are retried
+     */
+    virtual void run() = 0;
+
+    /**
+     * @brief Make run() return; may be called from any thread, e.g., a signal handling thread
+     */
+    virtual void stop() = 0;
+};
+
+#endif // PROCESSING_SERVER_INTERFACE_H
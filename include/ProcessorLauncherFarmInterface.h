@@ -0,0 +1,63 @@
+#ifndef PROCESSOR_LAUNCHER_FARM_INTERFACE_H
+#define PROCESSOR_LAUNCHER_FARM_INTERFACE_H
+
+#include "ProcessorLauncherInterface.h"
+
+#include <cstdint>
+#include <memory>
+
+/**
+ * Public interface of a farm that processes many streams on a fixed pool of worker threads.
+ * Each stream owns a launcher (and thereby all of its processing state). Blocks submitted to a
+ * stream are processed in submission order, but may be picked up by any worker of the farm.
+ */
+class ProcessorLauncherFarmInterface {
+public:
+    /**
+     * @brief Default destructor
+     */
+    virtual ~ProcessorLauncherFarmInterface() = default;
+
+    /**
+     * @brief Add a stream to the farm; the farm takes ownership of the launcher
+     * @param launcher [in] configured launcher that processes the blocks of the stream
+     * @param nchannels_in [in] number of channels of the input audio data submitted to the stream
+     * @param nchannels_out [in] number of channels of the output audio data submitted to the stream
+     * @return identifier of the stream; required to submit blocks
+     */
+    virtual uint32_t add_stream(std::unique_ptr<ProcessorLauncherInterface> launcher, uint32_t nchannels_in, uint32_t nchannels_out) = 0;
+
+    /**
+     * @brief Remove a stream from the farm and wait for its pending blocks. Calls that refer to the stream afterwards
+     * throw; calls that are already in flight finish safely.
+     * @param stream_id [in] identifier of the stream to remove
+     */
+    virtual void remove_stream(uint32_t stream_id) = 0;
+
+    /**
+     * @brief Submit a block for processing. Returns immediately; input and output must stay valid until the block completed.
+     * @param stream_id [in] identifier of the stream the block belongs to
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param output [in/out] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     */
+    virtual void submit(uint32_t stream_id, float const* const* input, float* const* output, int nsamples) = 0;
+
+    /**
+     * @brief Wait until all blocks submitted to a stream have been processed. Rethrows the first error that occurred while processing.
+     * @param stream_id [in] identifier of the stream to wait for
+     */
+    virtual void wait(uint32_t stream_id) = 0;
+
+    /**
+     * @brief Wait until all blocks submitted to all streams have been processed
+     */
+    virtual void wait_all() = 0;
+
+    /**
+     * @brief Get the number of worker threads of the farm
+     */
+    virtual uint32_t get_worker_count() const = 0;
+};
+
+#endif // PROCESSOR_LAUNCHER_FARM_INTERFACE_H
@@ -3,6 +3,93 @@
 
 #include <cstdint>
 
+/**
+ * Processing mode of a processor launcher
+ */
+enum class ProcessingMode {
+    // launches sized and configured for low latency
+    eRealtime,
+    // launches sized and configured for throughput, e.g., to render files
+    eOffline
+};
+
+/**
+ * What a launcher writes to the output of a process() call that misses its deadline. A call that misses because the
+ * launches of a previous call are still running is never processed: its input is lost to the processors, s.t. stateful
+ * processors (e.g., filters) continue from the previous block as if it didn't exist. Calls that miss because they are
+ * late or predicted to be late are still processed.
+ */
+enum class DeadlinePolicy {
+    // copy the input to the output
+    ePassThrough,
+    // write silence
+    eSilence,
+    // repeat the output of the last process() call that met its deadline
+    eHoldPrevious
+};
+
+/**
+ * What a launcher writes to the output channels of inactive channels; see process() with a channel activity mask
+ */
+enum class InactiveChannelOutput {
+    // write silence
+    eZero,
+    // leave the output channels untouched
+    eUntouched
+};
+
+/**
+ * What happens to the state of the processors across blocks without active channels; see process() with a channel
+ * activity mask
+ */
+enum class InactiveChannelState {
+    // keep the state; processing continues where the last block with active channels left off
+    eFrozen,
+    // recreate the processors before the next block with active channels, which starts from their initial state
+    eReset
+};
+
+/**
+ * Deadline of process() calls; see DeadlinePolicy for which missed blocks the processors still see
+ */
+struct DeadlineConfig {
+    DeadlinePolicy policy {DeadlinePolicy::eSilence};
+    // deadline of each process() call in microseconds; 0 derives the deadline from the block size and the sample rate
+    uint32_t deadline_us {0u};
+    // sample rate of the audio data; used to derive the deadline of a block of nsamples as nsamples / sample_rate
+    float sample_rate {48000.f};
+};
+
+/**
+ * Counters of a processor launcher
+ */
+struct LauncherStatistics {
+    // number of launches that were issued to the device
+    uint64_t launches {0u};
+    // number of launches that were skipped because the input was silent and the tail of the chain had decayed
+    uint64_t skipped_launches {0u};
+    // number of process() calls that missed their deadline and were answered according to the deadline policy
+    uint64_t deadline_misses {0u};
+};
+
+/**
+ * Host memory held by a launcher in bytes. Device memory of the processors is not exposed by the engine and not included.
+ */
+struct MemoryFootprint {
+    // copies of the processor specifications
+    uint64_t processor_specs {0u};
+    // input and output buffers of the executor while armed; estimated from the buffer configuration, assuming double buffering
+    uint64_t executor_buffers {0u};
+    // routing and staging buffers and channel pointer arrays of the launcher
+    uint64_t scratch {0u};
+    // buffers of the deadline executor, if a deadline is set
+    uint64_t deadline_buffers {0u};
+
+    uint64_t total() const {
+        return processor_specs + executor_buffers + scratch + deadline_buffers;
+    }
+};
+
 /**
  * Public interface for the processor launcher library
  */
@@ -15,11 +102,58 @@ public:
 
     /**
      * @brief Process samples provided in input and write them to output buffers.
+     * Processing in place is supported: an output channel may be the same buffer as an input channel, also if the samples
+     * are split into multiple launches. Channels must either be the same buffer or not overlap at all.
      * @param input [in] pointer to pointers to the channels of the input audio data
      * @param output [in/out] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel; larger blocks than the launcher's capacity are split into multiple launches
      */
     virtual void process(float const* const* input, float* const* output, const int nsamples) = 0;
 
+    /**
+     * @brief Process samples with a per-block channel activity mask. Inactive input channels read silence instead of
+     * the caller's buffers; without a routing matrix, output channel ch belongs to input channel ch and is written
+     * according to set_inactive_channel_output. The mask does not reduce transfers or compute: the engine launches all
+     * channels of a chain at once, so a block with at least one active channel transfers and processes all channels,
+     * and the processors see silence on the inactive ones, i.e., their state rings out. Only a block without active
+     * channels saves its launches; the state of the processors then follows set_inactive_channel_state.
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param output [in/out] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     * @param active_channels [in] one entry per input channel; 0 marks an inactive channel. nullptr processes all channels
+     */
+    virtual void process(float const* const* input, float* const* output, const int nsamples, uint8_t const* active_channels) = 0;
+
+    /**
+     * @brief Set what process() with a channel activity mask writes to the output channels of inactive channels
+     * @param policy [in] zero the outputs (default) or leave them untouched
+     */
+    virtual void set_inactive_channel_output(InactiveChannelOutput policy) = 0;
+
+    /**
+     * @brief Set what happens to the state of the processors across blocks that process() with a channel activity mask
+     * skips because no channel is active
+     * @param policy [in] keep the state (default) or start from freshly created processors once channels become active again
+     */
+    virtual void set_inactive_channel_state(InactiveChannelState policy) = 0;
+
+    /**
+     * @brief Render a long signal offline on several launchers in parallel. The signal is split into up to nsegments segments;
+     * each segment is rendered on its own launcher with the configuration and processors of this one, starting from freshly
+     * created processors. Every segment but the first is preceded by a pre-roll of the sum of the processors' tails
+     * (see load_processor) whose output is discarded, s.t. the processors' state has converged at the segment boundary.
+     * The output matches a serial render of the whole signal as far as the tails cover the processors' memory.
+     * Throws if the signal is split and the tail of a loaded processor is neither derived from its specification nor
+     * declared, as the pre-roll can't be sized; declare the tail of other processors with load_processor.
+     * This launcher's own processors are not used; the launches of all segments count in its statistics.
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param output [in/out] pointer to pointers to the channels of the output audio data; may be the same as input
+     * @param nsamples [in] number of samples per channel
+     * @param nsegments [in] maximum number of segments; 0 uses one segment per hardware thread. At most 8 segments are used,
+     * as each creates its own processors and buffers.
+     */
+    virtual void render_segmented(float const* const* input, float* const* output, uint32_t nsamples, uint32_t nsegments = 0u) = 0;
+
     /**
      * @brief Get the client library ready for processing with the current configuration
      */
@@ -30,13 +164,87 @@ public:
      */
     virtual void disarm() = 0;
 
+    /**
+     * @brief Run silent launches of the maximum buffer size s.t. the first real block doesn't pay for first-launch setup
+     * or cold caches, then re-arm with freshly created processors s.t. the first real block starts from the processors'
+     * initial state. The warm-up launches don't count in the statistics and aren't captured. Meant to be called before
+     * the first block: re-arming discards the state of processors that already processed audio, e.g., a filter's memory.
+     * @param nblocks [in] number of silent launches to run
+     * @return median duration of the silent launches in microseconds; 0 if nblocks is 0
+     */
+    virtual double warm_up(uint32_t nblocks) = 0;
+
     /**
      * @brief Load a processor into the launcher
      * @param p_id [in] Unique identifier of the processor to load; see processor's ModuleInfoProvider
      * @param p_data [in] Pointer to the processor's specification; see the processor's constructor
      * @param p_data_size [in] Size of p_data in bytes
+     * @param tail_samples [in] Number of samples the processor's output keeps ringing after its input turned silent. The tail
+     * of the gain, fir and iir processors is derived from their specification; a larger value given here takes precedence.
+     * Other processors have no tail unless one is given.
+     */
+    virtual void load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size, uint32_t tail_samples = 0u) = 0;
+
+    /**
+     * @brief Save the configuration and the loaded processors to a binary snapshot; see createGpuProcessorLauncherFromSnapshot
+     * @param snapshot_path [in] path of the snapshot file to write
+     */
+    virtual void save_snapshot(char const* snapshot_path) = 0;
+
+    /**
+     * @brief Start recording the configuration, the loaded processors, the current silence skipping, deadline, inactive
+     * channel output and state settings, and the input and channel activity mask of every following process() call to a capture file;
+     * see openCapture and the proc_replay tool. The blocks are written by a background thread; if it falls behind or
+     * fails, the capture stops and stop_capture() throws. Must not be called concurrently with process().
+     * @param capture_path [in] path of the capture file to write
+     */
+    virtual void start_capture(char const* capture_path) = 0;
+
+    /**
+     * @brief Stop recording, write the remaining blocks and close the capture file; throws if the capture stopped early.
+     * Must not be called concurrently with process().
+     */
+    virtual void stop_capture() = 0;
+
+    /**
+     * @brief Enable or disable skipping launches on silent input. Silent input is still processed until the tail of the
+     * chain (the sum of the processors' tails) has decayed; after that, silence is written to the output without launching.
+     * @param enable [in] true to skip launches on silent input
+     * @param threshold [in] largest absolute input sample value that still counts as silence
+     */
+    virtual void set_silence_skipping(bool enable, float threshold) = 0;
+
+    /**
+     * @brief Limit the time a process() call may take. The launches run on a separate thread; if they don't finish in time,
+     * the launches of a previous call are still running, or the median of the recent launches took longer than the deadline,
+     * the output is written according to the policy and the late result is discarded once it arrives. A call that finds
+     * the launches of a previous call still running is not processed at all. Launches that fail count as
+     * missed and the next process() call throws their error. Throws if the deadline is derived from the block size and
+     * the sample rate is not positive.
+     * @param config [in] deadline and policy
+     */
+    virtual void set_deadline(DeadlineConfig const& config) = 0;
+
+    /**
+     * @brief Remove the deadline; process() waits for the launches again
+     */
+    virtual void clear_deadline() = 0;
+
+    /**
+     * @brief Get the counters of the launcher
+     */
+    virtual LauncherStatistics get_statistics() const = 0;
+
+    /**
+     * @brief Get the host memory held by the launcher. Must not be called concurrently with load_processor or process.
+     */
+    virtual MemoryFootprint get_memory_footprint() const = 0;
+
+    /**
+     * @brief Limit the host memory of the launcher; arm() throws if the footprint would exceed the budget
+     * @param budget_bytes [in] maximum footprint in bytes; 0 disables the limit
      */
-    virtual void load_processor(wchar_t const* p_id, void const* p_data, uint32_t p_data_size) = 0;
+    virtual void set_memory_budget(uint64_t budget_bytes) = 0;
 };
 
 #endif // PROCESSOR_LAUNCHER_INTERFACE_H
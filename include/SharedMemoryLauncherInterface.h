@@ -0,0 +1,32 @@
+#ifndef SHARED_MEMORY_LAUNCHER_INTERFACE_H
+#define SHARED_MEMORY_LAUNCHER_INTERFACE_H
+
+#include "ProcessorLauncherInterface.h"
+
+#include <cstdint>
+
+/**
+ * Public interface of a launcher that processes on a local processing server (Linux only); see createSharedMemoryLauncher.
+ * In addition to process(), the caller can write a block straight to the memory the server processes and read the result
+ * from there, which saves the copies into and out of the shared memory.
+ */
+class SharedMemoryLauncherInterface : public ProcessorLauncherInterface {
+public:
+    /**
+     * @brief Get the shared memory to write the input of the next block to; arms the launcher if needed.
+     * The buffers have the fixed capacity of the stream, nsamples_per_channel samples per channel, and never grow;
+     * larger blocks must be passed to process(), which splits them.
+     * @param nsamples [in] number of samples per channel that will be written; throws if it exceeds the capacity
+     * @return pointers to the nchannels_in input channels; valid until the launcher is disarmed
+     */
+    virtual float* const* acquire_input(uint32_t nsamples) = 0;
+
+    /**
+     * @brief Let the server process the block written to the buffers of acquire_input and wait for it
+     * @param nsamples [in] number of samples per channel to process; throws if more than acquired
+     * @return pointers to the nchannels_out output channels in the shared memory; valid until the next acquire_input call
+     */
+    virtual float const* const* commit(uint32_t nsamples) = 0;
+};
+
+#endif // SHARED_MEMORY_LAUNCHER_INTERFACE_H
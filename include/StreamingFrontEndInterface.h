@@ -0,0 +1,58 @@
+#ifndef STREAMING_FRONT_END_INTERFACE_H
+#define STREAMING_FRONT_END_INTERFACE_H
+
+#include <cstdint>
+
+/**
+ * Counters and fill levels of a streaming front-end
+ */
+struct StreamingStatistics {
+    // number of pull_output calls that found less output than requested and filled up with silence
+    uint64_t underruns {0u};
+    // number of push_input calls that found less space than required and dropped input
+    uint64_t overruns {0u};
+    // number of blocks whose processing failed and that were replaced by silence
+    uint64_t failed_blocks {0u};
+    // number of samples per channel currently buffered in the input ring
+    uint32_t input_fill {0u};
+    // number of samples per channel currently buffered in the output ring
+    uint32_t output_fill {0u};
+    // lowest output fill level observed by pull_output; the part of the safety margin that was never needed
+    uint32_t min_output_fill {0u};
+};
+
+/**
+ * Public interface of a streaming front-end that decouples an audio callback from the launches.
+ * push_input and pull_output only copy memory and never wait; a dedicated thread processes the input in blocks.
+ * Both must be called from the same (audio callback) thread.
+ */
+class StreamingFrontEndInterface {
+public:
+    /**
+     * @brief Default destructor
+     */
+    virtual ~StreamingFrontEndInterface() = default;
+
+    /**
+     * @brief Queue input samples for processing. Samples that don't fit into the input ring are dropped and counted as overrun.
+     * @param input [in] pointer to pointers to the channels of the input audio data
+     * @param nsamples [in] number of samples per channel
+     * @return number of samples per channel that were queued
+     */
+    virtual uint32_t push_input(float const* const* input, uint32_t nsamples) = 0;
+
+    /**
+     * @brief Take processed samples. Missing samples are filled with silence and counted as underrun.
+     * @param output [in/out] pointer to pointers to the channels of the output audio data
+     * @param nsamples [in] number of samples per channel
+     * @return number of processed samples per channel that were copied to output
+     */
+    virtual uint32_t pull_output(float* const* output, uint32_t nsamples) = 0;
+
+    /**
+     * @brief Get the counters and fill levels of the front-end
+     */
+    virtual StreamingStatistics get_statistics() const = 0;
+};
+
+#endif // STREAMING_FRONT_END_INTERFACE_H
@@ -0,0 +1,45 @@
+#ifndef THREAD_CONFIG_H
+#define THREAD_CONFIG_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Scheduling policy of a processing thread
+ */
+enum class ThreadScheduling {
+    // leave the scheduling policy of the thread untouched
+    eDefault,
+    // real-time first-in first-out scheduling (SCHED_FIFO; time-critical priority on Windows)
+    eFifo,
+    // real-time round-robin scheduling (SCHED_RR; time-critical priority on Windows)
+    eRoundRobin
+};
+
+/**
+ * Settings applied to processing threads; everything is left untouched by default
+ */
+struct ThreadConfig {
+    // CPUs the thread may run on; empty leaves the affinity untouched
+    std::vector<uint32_t> cpus;
+    ThreadScheduling scheduling {ThreadScheduling::eDefault};
+    // real-time priority; clamped to the range the policy supports
+    int priority {0};
+    // flush denormal results and inputs to zero (FTZ/DAZ)
+    bool flush_denormals {false};
+};
+
+/**
+ * The settings that were actually applied to a thread; a requested setting may fail, e.g., without the permission
+ * to use real-time scheduling or on platforms that don't support it
+ */
+struct ThreadReport {
+    std::string name;
+    bool affinity_applied {false};
+    bool scheduling_applied {false};
+    bool denormals_applied {false};
+    bool name_applied {false};
+};
+
+#endif // THREAD_CONFIG_H
@@ -0,0 +1,73 @@
+#include <GPUCreate.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Simple command line application to replay a capture written by ProcessorLauncherInterface::start_capture
+ * and to report the latency of every process() call
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Error: usage proc_replay.exe [--fast] [capture.bin]\n");
+        return 1;
+    }
+
+    // by default, the blocks are replayed at the recorded timing; --fast replays them back-to-back
+    bool const fast = argc > 2 && std::strcmp(argv[1], "--fast") == 0;
+    std::string capture_path(argv[argc - 1]);
+
+    std::unique_ptr<CaptureReaderInterface> capture;
+    std::unique_ptr<ProcessorLauncherInterface> proc_launcher;
+    try {
+        capture = openCapture(capture_path.c_str());
+        // the launcher is armed; the first block doesn't pay for creating the processors
+        proc_launcher = capture->create_launcher();
+    }
+    catch (std::exception const& e) {
+        printf("Could not open capture from %s: %s\n", capture_path.c_str(), e.what());
+        return 2;
+    }
+
+    uint32_t const nchannels_out = capture->get_nchannels_out();
+    std::vector<std::vector<float>> output(nchannels_out);
+    std::vector<float*> output_ptr(nchannels_out, nullptr);
+
+    std::vector<double> latencies_us;
+    CapturedBlock block;
+    auto const replay_start = std::chrono::steady_clock::now();
+    printf("block\tnsamples\tlatency_us\n");
+    while (capture->next_block(block)) {
+        for (uint32_t ch {0u}; ch < nchannels_out; ++ch) {
+            output[ch].resize(std::max<size_t>(output[ch].size(), block.nsamples));
+            output_ptr[ch] = output[ch].data();
+        }
+        if (!fast) {
+            std::this_thread::sleep_until(replay_start + std::chrono::nanoseconds(block.timestamp_ns));
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        proc_launcher->process(block.channels.data(), output_ptr.data(), static_cast<int>(block.nsamples), block.active_channels);
+        auto const end = std::chrono::steady_clock::now();
+
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        printf("%zu\t%u\t%.1f\n", latencies_us.size() - 1u, block.nsamples, latencies_us.back());
+    }
+
+    if (latencies_us.empty()) {
+        printf("Capture contains no blocks\n");
+        return 0;
+    }
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto const percentile = [&latencies_us](double p) { return latencies_us[static_cast<size_t>(p * static_cast<double>(latencies_us.size() - 1u))]; };
+    printf("Replayed %zu blocks: min %.1f us, median %.1f us, p99 %.1f us, max %.1f us\n", latencies_us.size(), latencies_us.front(), percentile(0.5), percentile(0.99), latencies_us.back());
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <GPUCreate.h>
+
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+/**
+ * Local processing server; owns the engine context and processes the blocks of all launchers created with
+ * createSharedMemoryLauncher on this host
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Error: usage proc_server [--capture-dir directory] [socket_path]\n");
+        return 1;
+    }
+
+    // without a capture directory, the clients' start_capture requests fail
+    char const* capture_directory {nullptr};
+    if (argc > 3 && std::strcmp(argv[1], "--capture-dir") == 0) {
+        capture_directory = argv[2];
+    }
+    std::string socket_path(argv[argc - 1]);
+
+    // handle SIGINT and SIGTERM on a dedicated thread; all threads started from here on inherit the blocked mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    std::unique_ptr<ProcessingServerInterface> server;
+    try {
+        server = createProcessingServer(socket_path.c_str(), capture_directory);
+    }
+    catch (std::exception const& e) {
+        printf("Could not start processing server on %s: %s\n", socket_path.c_str(), e.what());
+        return 2;
+    }
+
+    std::thread signal_thread([&server, &signals] {
+        int signal {0};
+        sigwait(&signals, &signal);
+        server->stop();
+    });
+
+    printf("Processing server listening on %s\n", socket_path.c_str());
+    // returns only once the signal thread called stop()
+    server->run();
+
+    signal_thread.join();
+    server.reset();
+    printf("Processing server stopped\n");
+
+    return 0;
+}